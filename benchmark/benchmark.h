@@ -0,0 +1,168 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H 1
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <x86intrin.h>
+
+/*
+
+    A small Google-Benchmark-style harness for timing filters on a trunk of data. Each benchmark registers a setup
+    function that allocates its data and returns the function to be timed, which filters len samples once.
+    Reported per benchmark:
+        samples/s: samples filtered per second.
+        cycles/sample: time stamp counter cycles per sample (reference cycles, not core cycles under turbo).
+        bytes/cycle: bytes read and written per cycle, i.e., bytes*len/cycles.
+    Command line (the same names as Google Benchmark):
+        --benchmark_filter=<substring>   run the benchmarks whose name contains the substring only
+        --benchmark_min_time=<seconds>   minimal time of each benchmark, 0.2 by default
+        --benchmark_out=<file>           write the results in JSON
+
+ */
+
+
+// extra values reported by a benchmark, e.g., the error against a reference
+using Counters = std::map<std::string, double>;
+
+// the function filtering one trunk, returned by the setup of a benchmark
+using Run = std::function<void()>;
+
+struct Benchmark {
+    // name of the benchmark, e.g., filter/option3/Vec8f/order:12/len:4096
+    std::string name;
+    // number of samples per run
+    long len;
+    // bytes read and written per sample
+    int bytes;
+    // allocate data and return the function to be timed
+    std::function<Run(long, Counters&)> setup;
+};
+
+struct BenchmarkResult {
+    std::string name;
+    long len, iterations;
+    double ns_per_run, samples_per_second, cycles_per_sample, bytes_per_cycle;
+    Counters counters;
+};
+
+// registry of benchmarks
+inline std::vector<Benchmark>& benchmarks() {
+    static std::vector<Benchmark> b;
+    return b;
+};
+
+inline void register_benchmark(const std::string& name, const long len, const int bytes, std::function<Run(long, Counters&)> setup) {
+    benchmarks().push_back(Benchmark{name, len, bytes, setup});
+};
+
+// time one benchmark: one warm up run, then repeat until the minimal time is reached.
+inline BenchmarkResult run_benchmark(const Benchmark& b, const double min_time) {
+    BenchmarkResult r{b.name, b.len, 0, 0, 0, 0, 0, {}};
+
+    Run run = b.setup(b.len, r.counters);
+    run();
+
+    double ns = 0;
+    unsigned long long cycles = 0;
+
+    while (ns < min_time*1e9) {
+        auto start = std::chrono::steady_clock::now();
+        unsigned long long c0 = __rdtsc();
+
+        run();
+
+        unsigned long long c1 = __rdtsc();
+        auto finish = std::chrono::steady_clock::now();
+
+        ns += std::chrono::duration<double, std::nano>(finish - start).count();
+        cycles += c1 - c0;
+        r.iterations++;
+    }
+
+    double samples = double(b.len)*r.iterations;
+
+    r.ns_per_run = ns/r.iterations;
+    r.samples_per_second = samples/(ns*1e-9);
+    r.cycles_per_sample = cycles/samples;
+    r.bytes_per_cycle = b.bytes*samples/cycles;
+
+    return r;
+};
+
+// write the results in JSON, in the layout of Google Benchmark
+inline void write_json(std::ostream& os, const std::vector<BenchmarkResult>& results) {
+    os << "{\n  \"context\": {\n";
+    os << "    \"library\": \"recursive_filter\",\n";
+    os << "    \"instrset\": " << INSTRSET << "\n";
+    os << "  },\n  \"benchmarks\": [\n";
+
+    for (size_t i=0; i<results.size(); i++) {
+        const BenchmarkResult& r = results[i];
+
+        os << "    {\n";
+        os << "      \"name\": \"" << r.name << "\",\n";
+        os << "      \"length\": " << r.len << ",\n";
+        os << "      \"iterations\": " << r.iterations << ",\n";
+        os << "      \"real_time\": " << r.ns_per_run << ",\n";
+        os << "      \"time_unit\": \"ns\",\n";
+        os << "      \"samples_per_second\": " << r.samples_per_second << ",\n";
+        os << "      \"cycles_per_sample\": " << r.cycles_per_sample << ",\n";
+        os << "      \"bytes_per_cycle\": " << r.bytes_per_cycle;
+        for (auto& c: r.counters) os << ",\n      \"" << c.first << "\": " << c.second;
+        os << "\n    }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    os << "  ]\n}\n";
+};
+
+// run all registered benchmarks matching the filter, print a table and optionally write JSON.
+inline int run_benchmarks(int argc, char** argv) {
+    std::string filter, out;
+    double min_time = 0.2;
+
+    for (auto i=1; i<argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg.rfind("--benchmark_filter=", 0) == 0) filter = arg.substr(19);
+        else if (arg.rfind("--benchmark_min_time=", 0) == 0) min_time = std::stod(arg.substr(21));
+        else if (arg.rfind("--benchmark_out=", 0) == 0) out = arg.substr(16);
+        else {
+            std::cerr << "unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+
+    std::printf("%-56s %14s %10s %14s %14s %12s\n", "Benchmark", "Time(ns)", "Iterations", "samples/s", "cycles/sample", "bytes/cycle");
+
+    for (auto& b: benchmarks()) {
+        if (b.name.find(filter) == std::string::npos) continue;
+
+        BenchmarkResult r = run_benchmark(b, min_time);
+
+        std::printf("%-56s %14.0f %10ld %14.4g %14.4f %12.4f", r.name.c_str(), r.ns_per_run, r.iterations,
+                    r.samples_per_second, r.cycles_per_sample, r.bytes_per_cycle);
+        for (auto& c: r.counters) std::printf(" %s=%g", c.first.c_str(), c.second);
+        std::printf("\n");
+
+        results.push_back(r);
+    }
+
+    if (!out.empty()) {
+        std::ofstream os(out);
+        write_json(os, results);
+    }
+
+    return 0;
+};
+
+#define BENCHMARK_MAIN() int main(int argc, char** argv) { return run_benchmarks(argc, argv); }
+
+#endif // header guard
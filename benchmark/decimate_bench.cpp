@@ -0,0 +1,73 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <cmath>
+#include <memory>
+
+/*
+    decimating filter: the operator storing every output and then keeping every D-th of them, against decimate, which
+    forwards only the kept blocks in ICC_T of the last section and stores the kept outputs only.
+ */
+
+const long lengths[] = {1<<14, 1<<18, 1<<24};
+
+// stable sections with poles of radius 0.9 spread over the upper half plane
+template<typename T, int N> void make_coeffs(T (&coefs)[N][5], T (&inits)[N][4]) {
+    const double r = 0.9, pi = 3.14159265358979323846;
+
+    for (auto i=0; i<N; i++) {
+        double theta = pi*(i + 0.5)/N;
+
+        coefs[i][0] = 1;
+        coefs[i][1] = 0.5;
+        coefs[i][2] = 0.25;
+        coefs[i][3] = 2*r*std::cos(theta);
+        coefs[i][4] = -r*r;
+
+        for (auto k=0; k<4; k++) inits[i][k] = 0;
+    }
+};
+
+template<typename V, int N> void register_decimate(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const char* options[] = {"operator", "decimate"};
+
+    for (auto len: lengths) {
+        for (auto D: {2, 4, 8, 16}) {
+            for (auto op=0; op<2; op++) {
+
+                std::string name = std::string("decimate/") + options[op] + "/" + vec + "/order:" + std::to_string(2*N) + "/D:" + std::to_string(D) + "/len:" + std::to_string(len);
+
+                register_benchmark(name, len, sizeof(T), [op, D](long len, Counters&) -> Run {
+                    T coefs[N][5], inits[N][4];
+                    make_coeffs(coefs, inits);
+
+                    auto F = std::make_shared<Filter<T,N,V>>(coefs, inits);
+                    auto in = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len);
+
+                    // a signal that keeps away from denormals
+                    for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+                    return [=]() {
+                        if (op == 0) {
+                            (*F)(in->begin(), in->end(), out->begin());
+                            for (long k=0; k<len/D; k++) (*out)[k] = (*out)[k*D];
+                        }
+                        if (op == 1) F->decimate(in->begin(), in->end(), out->begin(), D);
+                    };
+                });
+            }
+        }
+    }
+};
+
+static int registered = []() {
+    register_decimate<Vec4f,6>("Vec4f");
+    register_decimate<Vec8f,6>("Vec8f");
+    register_decimate<Vec16f,6>("Vec16f");
+    register_decimate<Vec4d,6>("Vec4d");
+    register_decimate<Vec8d,6>("Vec8d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
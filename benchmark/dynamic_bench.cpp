@@ -0,0 +1,78 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <cmath>
+#include <memory>
+
+/*
+    operator of DynamicFilter (number of sections at run time) against the operator of Filter (number of sections
+    as the template parameter, i.e., the tuple of Series) for the same sections.
+ */
+
+const long lengths[] = {1<<10, 1<<14, 1<<18, 1<<24};
+
+// stable sections with poles of radius 0.9 spread over the upper half plane
+template<typename T, int N> void make_coeffs(T (&coefs)[N][5], T (&inits)[N][4]) {
+    const double r = 0.9, pi = 3.14159265358979323846;
+
+    for (auto i=0; i<N; i++) {
+        double theta = pi*(i + 0.5)/N;
+
+        coefs[i][0] = 1;
+        coefs[i][1] = 0.5;
+        coefs[i][2] = 0.25;
+        coefs[i][3] = 2*r*std::cos(theta);
+        coefs[i][4] = -r*r;
+
+        for (auto k=0; k<4; k++) inits[i][k] = 0;
+    }
+};
+
+template<typename V, int N> void register_dynamic(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const char* options[] = {"template", "dynamic"};
+
+    for (auto len: lengths) {
+        for (auto op=0; op<2; op++) {
+
+            std::string name = std::string("dynamic/") + options[op] + "/" + vec + "/sections:" + std::to_string(N) + "/len:" + std::to_string(len);
+
+            register_benchmark(name, len, 2*sizeof(T), [op](long len, Counters&) -> Run {
+                T coefs[N][5], inits[N][4];
+                make_coeffs(coefs, inits);
+
+                auto F = std::make_shared<Filter<T,N,V>>(coefs, inits);
+                auto D = std::make_shared<DynamicFilter<T,V>>(coefs, inits, N);
+                auto in = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len);
+
+                // a signal that keeps away from denormals
+                for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+                return [=]() {
+                    if (op == 0) (*F)(in->begin(), in->end(), out->begin());
+                    if (op == 1) (*D)(in->begin(), in->end(), out->begin());
+                };
+            });
+        }
+    }
+};
+
+// 1 to 40 sections
+template<typename V> void register_sections(const char* vec) {
+    register_dynamic<V,1>(vec);
+    register_dynamic<V,6>(vec);
+    register_dynamic<V,12>(vec);
+    register_dynamic<V,20>(vec);
+    register_dynamic<V,40>(vec);
+};
+
+static int registered = []() {
+    register_sections<Vec4f>("Vec4f");
+    register_sections<Vec8f>("Vec8f");
+    register_sections<Vec16f>("Vec16f");
+    register_sections<Vec4d>("Vec4d");
+    register_sections<Vec8d>("Vec8d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
@@ -0,0 +1,84 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <cmath>
+#include <memory>
+
+/*
+    throughput of Filter for every cascade strategy (scalar, option 1, 2, 3), SIMD vector (float and double),
+    filter order (2 to 32) and length of data (from L1 resident to DRAM bound).
+ */
+
+// lengths of data: in and out fit in L1, L2, L3, and DRAM.
+const long lengths[] = {1<<10, 1<<14, 1<<18, 1<<24};
+
+// stable sections with poles of radius 0.9 spread over the upper half plane, y_n = x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
+template<typename T, int N> void make_coeffs(T (&coefs)[N][5], T (&inits)[N][4]) {
+    const double r = 0.9, pi = 3.14159265358979323846;
+
+    for (auto i=0; i<N; i++) {
+        double theta = pi*(i + 0.5)/N;
+
+        coefs[i][0] = 1;
+        coefs[i][1] = 0.5;
+        coefs[i][2] = 0.25;
+        coefs[i][3] = 2*r*std::cos(theta);
+        coefs[i][4] = -r*r;
+
+        for (auto k=0; k<4; k++) inits[i][k] = 0;
+    }
+};
+
+// register the four cascade strategies of Filter<T,N,V> for each length.
+template<typename V, int N> void register_filter(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const char* options[] = {"scalar", "option1", "option2", "option3"};
+
+    for (auto len: lengths) {
+        for (auto op=0; op<4; op++) {
+
+            std::string name = std::string("filter/") + options[op] + "/" + vec + "/order:" + std::to_string(2*N) + "/len:" + std::to_string(len);
+
+            register_benchmark(name, len, 2*sizeof(T), [op](long len, Counters&) -> Run {
+                T coefs[N][5], inits[N][4];
+                make_coeffs(coefs, inits);
+
+                auto F = std::make_shared<Filter<T,N,V>>(coefs, inits);
+                auto in = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len);
+
+                // a signal that keeps away from denormals
+                for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+                return [=]() {
+                    if (op == 0) F->cascaded_scalar(in->begin(), in->end(), out->begin());
+                    if (op == 1) F->cascaded_option1(in->begin(), in->end(), out->begin());
+                    if (op == 2) F->cascaded_option2(in->begin(), in->end(), out->begin());
+                    if (op == 3) F->cascaded_option3(in->begin(), in->end(), out->begin());
+                };
+            });
+        }
+    }
+};
+
+// filter orders 2, 4, 8, 12, 16, 24, 32
+template<typename V> void register_orders(const char* vec) {
+    register_filter<V,1>(vec);
+    register_filter<V,2>(vec);
+    register_filter<V,4>(vec);
+    register_filter<V,6>(vec);
+    register_filter<V,8>(vec);
+    register_filter<V,12>(vec);
+    register_filter<V,16>(vec);
+};
+
+static int registered = []() {
+    register_orders<Vec4f>("Vec4f");
+    register_orders<Vec8f>("Vec8f");
+    register_orders<Vec16f>("Vec16f");
+    register_orders<Vec2d>("Vec2d");
+    register_orders<Vec4d>("Vec4d");
+    register_orders<Vec8d>("Vec8d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
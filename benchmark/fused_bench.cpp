@@ -0,0 +1,93 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <cmath>
+#include <memory>
+
+/*
+    fused cascade against Series of option 3 on the same tiles:
+    series: Series built by series_from_coeffs, one core object per section with its own coefficients and shift registers.
+    fused: FusedSeries, the coefficients of all sections in one aligned block and the tile passed through every section.
+ */
+
+const long lengths[] = {1<<10, 1<<14, 1<<18, 1<<24};
+
+// stable sections with poles of radius 0.9 spread over the upper half plane
+template<typename T, int N> void make_coeffs(T (&coefs)[N][5], T (&inits)[N][4]) {
+    const double r = 0.9, pi = 3.14159265358979323846;
+
+    for (auto i=0; i<N; i++) {
+        double theta = pi*(i + 0.5)/N;
+
+        coefs[i][0] = 1;
+        coefs[i][1] = 0.5;
+        coefs[i][2] = 0.25;
+        coefs[i][3] = 2*r*std::cos(theta);
+        coefs[i][4] = -r*r;
+
+        for (auto k=0; k<4; k++) inits[i][k] = 0;
+    }
+};
+
+// filter the data tile by tile with the transposes at head and tail, S is either Series or FusedSeries.
+template<typename V, typename S, typename T> void filter_tiles(S& s, const T* in, T* out, const long len) {
+    constexpr int M = V::size();
+    std::array<V,M> x;
+
+    for (long l=0; l + M*M <= len; l += M*M) {
+        for (auto n=0; n<M; n++) x[n].load(in + l + n*M);
+        _permuteV_inplace(x);
+        s.series_option3_inplace(x);
+        _permuteV_inplace(x);
+        for (auto n=0; n<M; n++) x[n].store(out + l + n*M);
+    }
+};
+
+template<typename V, int N> void register_fused(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const char* options[] = {"series", "fused"};
+
+    for (auto len: lengths) {
+        for (auto op=0; op<2; op++) {
+
+            std::string name = std::string("fused/") + options[op] + "/" + vec + "/order:" + std::to_string(2*N) + "/len:" + std::to_string(len);
+
+            register_benchmark(name, len, 2*sizeof(T), [op](long len, Counters&) -> Run {
+                T coefs[N][5], inits[N][4];
+                make_coeffs(coefs, inits);
+
+                auto S = std::make_shared<decltype(series_from_coeffs<T,V>(coefs, inits))>(series_from_coeffs<T,V>(coefs, inits));
+                auto F = std::make_shared<FusedSeries<V,N>>(coefs, inits);
+                auto in = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len);
+
+                // a signal that keeps away from denormals
+                for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+                return [=]() {
+                    if (op == 0) filter_tiles<V>(*S, in->data(), out->data(), len);
+                    if (op == 1) filter_tiles<V>(*F, in->data(), out->data(), len);
+                };
+            });
+        }
+    }
+};
+
+// filter orders 4, 12, 24, 32
+template<typename V> void register_orders(const char* vec) {
+    register_fused<V,2>(vec);
+    register_fused<V,6>(vec);
+    register_fused<V,12>(vec);
+    register_fused<V,16>(vec);
+};
+
+static int registered = []() {
+    register_orders<Vec4f>("Vec4f");
+    register_orders<Vec8f>("Vec8f");
+    register_orders<Vec16f>("Vec16f");
+    register_orders<Vec2d>("Vec2d");
+    register_orders<Vec4d>("Vec4d");
+    register_orders<Vec8d>("Vec8d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
@@ -0,0 +1,74 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <memory>
+
+/*
+    copy elimination on the 12th order filter of example/filter.cpp:
+    option3: cascaded_option3, copies the matrix into x_T, y_T and y, and each core returns its matrix by value.
+    tile: operator(), one register tile passed through the cores by reference.
+    inplace: filter_inplace, the operator on a single buffer.
+    filtfilt: zero-phase filtering, the backward pass reversed inside the transpose stage.
+    filtfilt_copy: zero-phase filtering by the operator, reversing the output into a copy and back.
+    transposed: the operator on data in the tile order, without the two transposes of each matrix.
+ */
+
+const long lengths[] = {1<<10, 1<<14, 1<<18, 1<<24};
+
+template<typename V> void register_inplace(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const char* options[] = {"option3", "tile", "inplace", "filtfilt", "filtfilt_copy", "transposed"};
+
+    for (auto len: lengths) {
+        for (auto op=0; op<6; op++) {
+
+            std::string name = std::string("inplace/") + options[op] + "/" + vec + "/order:12/len:" + std::to_string(len);
+
+            register_benchmark(name, len, 2*sizeof(T), [op](long len, Counters&) -> Run {
+                T inits[6][4] = {0.2,0.3,0.4,0.5
+                                ,0.5,0.7,0.9,3
+                                ,-2,2.1,3,9
+                                ,2.2,2.3,0.5,0.3
+                                ,-2,-3,5,7
+                                ,2,3,1,8
+                                };
+                T coefs[6][5] = {1,-0.5,0.25,-0.75,0.6
+                                ,1,0.5,0.7,0.9,0.1
+                                ,1,-0.2,0.2,0.3,0.9
+                                ,1,-0.4,0.5,0.5,0.1
+                                ,1,-0.25,-0.3,0.15,0.7
+                                ,1,0.12,0.23,0.31,0.8
+                                };
+
+                auto F = std::make_shared<Filter<T,6,V>>(coefs, inits);
+                auto in = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len), tmp = std::make_shared<std::vector<T>>(len);
+
+                // a signal that keeps away from denormals
+                for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+                return [=]() {
+                    if (op == 0) F->cascaded_option3(in->begin(), in->end(), out->begin());
+                    if (op == 1) (*F)(in->begin(), in->end(), out->begin());
+                    if (op == 2) F->filter_inplace(*out);
+                    if (op == 3) F->filtfilt(in->begin(), in->end(), out->begin(), PadType::none);
+                    if (op == 4) {
+                        (*F)(in->begin(), in->end(), tmp->begin());
+                        std::reverse_copy(tmp->begin(), tmp->end(), out->begin());
+                        (*F)(out->begin(), out->end(), tmp->begin());
+                        std::reverse_copy(tmp->begin(), tmp->end(), out->begin());
+                    }
+                    if (op == 5) F->transposed(in->begin(), in->end(), out->begin());
+                };
+            });
+        }
+    }
+};
+
+static int registered = []() {
+    register_inplace<Vec4f>("Vec4f");
+    register_inplace<Vec8f>("Vec8f");
+    register_inplace<Vec16f>("Vec16f");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
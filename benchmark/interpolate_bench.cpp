@@ -0,0 +1,74 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <cmath>
+#include <memory>
+
+/*
+    interpolating filter: the operator on the input upsampled by L with zeros (stuffed in a buffer), against interpolate,
+    which computes the particular part of the first section from the low rate samples only.
+ */
+
+const long lengths[] = {1<<14, 1<<18, 1<<24};
+
+// stable sections with poles of radius 0.9 spread over the upper half plane
+template<typename T, int N> void make_coeffs(T (&coefs)[N][5], T (&inits)[N][4]) {
+    const double r = 0.9, pi = 3.14159265358979323846;
+
+    for (auto i=0; i<N; i++) {
+        double theta = pi*(i + 0.5)/N;
+
+        coefs[i][0] = 1;
+        coefs[i][1] = 0.5;
+        coefs[i][2] = 0.25;
+        coefs[i][3] = 2*r*std::cos(theta);
+        coefs[i][4] = -r*r;
+
+        for (auto k=0; k<4; k++) inits[i][k] = 0;
+    }
+};
+
+template<typename V, int N> void register_interpolate(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const char* options[] = {"operator", "interpolate"};
+
+    for (auto len: lengths) {
+        for (auto U: {2, 4, 8, 16}) {
+            for (auto op=0; op<2; op++) {
+
+                std::string name = std::string("interpolate/") + options[op] + "/" + vec + "/order:" + std::to_string(2*N) + "/L:" + std::to_string(U) + "/len:" + std::to_string(len);
+
+                register_benchmark(name, len, sizeof(T), [op, U](long len, Counters&) -> Run {
+                    T coefs[N][5], inits[N][4];
+                    make_coeffs(coefs, inits);
+
+                    auto F = std::make_shared<Filter<T,N,V>>(coefs, inits);
+                    // len outputs from len/L low rate samples
+                    auto in = std::make_shared<std::vector<T>>(len/U), up = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len);
+
+                    // a signal that keeps away from denormals
+                    for (long n=0; n<len/U; n++) (*in)[n] = T(n%17 - 8);
+
+                    return [=]() {
+                        if (op == 0) {
+                            for (long k=0; k<len/U; k++) (*up)[k*U] = (*in)[k];
+                            (*F)(up->begin(), up->end(), out->begin());
+                        }
+                        if (op == 1) F->interpolate(in->begin(), in->end(), out->begin(), U);
+                    };
+                });
+            }
+        }
+    }
+};
+
+static int registered = []() {
+    register_interpolate<Vec4f,6>("Vec4f");
+    register_interpolate<Vec8f,6>("Vec8f");
+    register_interpolate<Vec16f,6>("Vec16f");
+    register_interpolate<Vec4d,6>("Vec4d");
+    register_interpolate<Vec8d,6>("Vec8d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
@@ -0,0 +1,118 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <cmath>
+#include <memory>
+#include <random>
+
+/*
+    error against throughput of the three precision modes of the operator (option 3), for poles approaching the unit circle:
+    float: Filter<float,N> by coefficients rounded to float.
+    mixed: Filter<float,N> by coefficients in double, i.e., pre-computations in double and the matrices in float.
+    double: Filter<double,N>.
+    max_rel_err: the maximal error against the scalar recurrence in long double, relative to the maximal magnitude of the output.
+ */
+
+const long lengths[] = {1<<16, 1<<20};
+
+// sections with poles of radius r spread over the upper half plane
+template<typename T, int N> void make_coeffs(const double r, T (&coefs)[N][5], T (&inits)[N][4]) {
+    const double pi = 3.14159265358979323846;
+
+    for (auto i=0; i<N; i++) {
+        double theta = pi*(i + 0.5)/N;
+
+        coefs[i][0] = 1;
+        coefs[i][1] = 0.5;
+        coefs[i][2] = 0.25;
+        coefs[i][3] = 2*r*std::cos(theta);
+        coefs[i][4] = -r*r;
+
+        for (auto k=0; k<4; k++) inits[i][k] = 0;
+    }
+};
+
+// the cascaded recurrence in long double as the reference
+template<int N> std::vector<long double> reference(const double (&coefs)[N][5], const std::vector<double>& x) {
+    std::vector<long double> y(x.begin(), x.end());
+
+    for (auto i=0; i<N; i++) {
+        long double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+        for (auto& v: y) {
+            long double w = coefs[i][0]*v + coefs[i][1]*x1 + coefs[i][2]*x2 + coefs[i][3]*y1 + coefs[i][4]*y2;
+
+            x2 = x1; x1 = v;
+            y2 = y1; y1 = w;
+            v = w;
+        }
+    }
+
+    return y;
+};
+
+template<int N> void register_precision(const double r, const char* radius) {
+
+    const char* modes[] = {"float", "mixed", "double"};
+
+    for (auto len: lengths) {
+        for (auto mode=0; mode<3; mode++) {
+
+            std::string name = std::string("precision/") + modes[mode] + "/order:" + std::to_string(2*N) + "/r:" + radius + "/len:" + std::to_string(len);
+
+            register_benchmark(name, len, (mode == 2) ? 16 : 8, [mode, r](long len, Counters& counters) -> Run {
+                double coefs_d[N][5], inits_d[N][4];
+                float coefs_f[N][5], inits_f[N][4];
+                make_coeffs(r, coefs_d, inits_d);
+                make_coeffs(r, coefs_f, inits_f);
+
+                // white noise
+                std::mt19937 gen(0);
+                std::uniform_real_distribution<double> dist(-1, 1);
+                std::vector<double> x(len);
+                for (auto& v: x) v = dist(gen);
+
+                std::vector<long double> ref = reference(coefs_d, x);
+
+                auto in_f = std::make_shared<std::vector<float>>(x.begin(), x.end()), out_f = std::make_shared<std::vector<float>>(len);
+                auto in_d = std::make_shared<std::vector<double>>(x), out_d = std::make_shared<std::vector<double>>(len);
+
+                std::shared_ptr<Filter<float,N>> F_f;
+                std::shared_ptr<Filter<double,N>> F_d;
+
+                if (mode == 0) F_f = std::make_shared<Filter<float,N>>(coefs_f, inits_f);
+                if (mode == 1) F_f = std::make_shared<Filter<float,N>>(coefs_d, inits_d);
+                if (mode == 2) F_d = std::make_shared<Filter<double,N>>(coefs_d, inits_d);
+
+                Run run = [=]() {
+                    if (mode < 2) (*F_f)(in_f->begin(), in_f->end(), out_f->begin());
+                    else (*F_d)(in_d->begin(), in_d->end(), out_d->begin());
+                };
+
+                // error of the first run from the zero state
+                run();
+
+                long double err = 0, mag = 0;
+
+                for (long n=0; n<len; n++) {
+                    long double y = (mode < 2) ? (*out_f)[n] : (*out_d)[n];
+
+                    err = std::max(err, std::fabs(y - ref[n]));
+                    mag = std::max(mag, std::fabs(ref[n]));
+                }
+
+                counters["max_rel_err"] = double(err/mag);
+
+                return run;
+            });
+        }
+    }
+};
+
+static int registered = []() {
+    register_precision<4>(0.99, "0.99");
+    register_precision<4>(0.999, "0.999");
+    register_precision<4>(0.9999, "0.9999");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
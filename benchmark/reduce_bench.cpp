@@ -0,0 +1,82 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+/*
+    statistics of the filtered signal (sum, energy, minimum and maximum) on the 12th order filter of example/filter.cpp:
+    store: the operator writes the outputs, which are read back for the statistics.
+    reduce: the output-less operator, each matrix of outputs reduced in registers.
+ */
+
+const long lengths[] = {1<<14, 1<<18, 1<<24};
+
+template<typename V> void register_reduce(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const char* options[] = {"store", "reduce"};
+
+    for (auto len: lengths) {
+        for (auto op=0; op<2; op++) {
+
+            std::string name = std::string("reduce/") + options[op] + "/" + vec + "/order:12/len:" + std::to_string(len);
+
+            register_benchmark(name, len, sizeof(T), [op](long len, Counters&) -> Run {
+                T inits[6][4] = {0};
+                T coefs[6][5] = {1,-0.5,0.25,-0.75,0.6
+                                ,1,0.5,0.7,0.9,0.1
+                                ,1,-0.2,0.2,0.3,0.9
+                                ,1,-0.4,0.5,0.5,0.1
+                                ,1,-0.25,-0.3,0.15,0.7
+                                ,1,0.12,0.23,0.31,0.8
+                                };
+
+                auto F = std::make_shared<Filter<T,6,V>>(coefs, inits);
+                auto in = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len);
+
+                // a signal that keeps away from denormals
+                for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+                // the statistics are written to the heap, thus neither path is optimized away
+                auto result = std::make_shared<double>(0);
+
+                return [=]() {
+                    if (op == 0) {
+                        (*F)(in->begin(), in->end(), out->begin());
+
+                        double sum = 0, energy = 0;
+                        T lo = INFINITY, hi = -INFINITY;
+
+                        for (auto v: *out) {
+                            sum += v;
+                            energy += v*v;
+                            lo = std::min(lo, v);
+                            hi = std::max(hi, v);
+                        }
+
+                        *result = sum + energy + lo + hi;
+                    }
+                    if (op == 1) {
+                        Statistics<V> stats;
+
+                        F->reduce(in->begin(), in->end(), stats);
+
+                        *result = stats.sum() + stats.energy() + stats.min() + stats.max();
+                    }
+                };
+            });
+        }
+    }
+};
+
+static int registered = []() {
+    register_reduce<Vec4f>("Vec4f");
+    register_reduce<Vec8f>("Vec8f");
+    register_reduce<Vec16f>("Vec16f");
+    register_reduce<Vec4d>("Vec4d");
+    register_reduce<Vec8d>("Vec8d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
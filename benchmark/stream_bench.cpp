@@ -0,0 +1,61 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+/*
+    streaming mode on trunks from DRAM, the 12th order filter of example/filter.cpp in huge page buffers:
+    copy: memcpy of the trunk, the bandwidth of the STREAM copy as the bound.
+    tile: the operator, unaligned loads and the stores through the cache (read for ownership of the output).
+    streaming: aligned loads, prefetch and non-temporal stores.
+ */
+
+// in and out exceed the last level cache
+const long lengths[] = {1<<22, 1<<24, 1<<26};
+
+template<typename V> void register_stream(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const char* options[] = {"copy", "tile", "streaming"};
+
+    for (auto len: lengths) {
+        for (auto op=0; op<3; op++) {
+
+            std::string name = std::string("stream/") + options[op] + "/" + vec + "/order:12/len:" + std::to_string(len);
+
+            register_benchmark(name, len, 2*sizeof(T), [op](long len, Counters&) -> Run {
+                T inits[6][4] = {0};
+                T coefs[6][5] = {1,-0.5,0.25,-0.75,0.6
+                                ,1,0.5,0.7,0.9,0.1
+                                ,1,-0.2,0.2,0.3,0.9
+                                ,1,-0.4,0.5,0.5,0.1
+                                ,1,-0.25,-0.3,0.15,0.7
+                                ,1,0.12,0.23,0.31,0.8
+                                };
+
+                auto F = std::make_shared<Filter<T,6,V>>(coefs, inits);
+                auto in = std::make_shared<huge_page_vector<T>>(len), out = std::make_shared<huge_page_vector<T>>(len);
+
+                // a signal that keeps away from denormals
+                for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+                return [=]() {
+                    if (op == 0) std::memcpy(out->data(), in->data(), len*sizeof(T));
+                    if (op == 1) (*F)(in->data(), in->data() + len, out->data());
+                    if (op == 2) F->streaming(in->data(), in->data() + len, out->data());
+                };
+            });
+        }
+    }
+};
+
+static int registered = []() {
+    register_stream<Vec8f>("Vec8f");
+    register_stream<Vec16f>("Vec16f");
+    register_stream<Vec4d>("Vec4d");
+    register_stream<Vec8d>("Vec8d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
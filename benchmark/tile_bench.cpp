@@ -0,0 +1,66 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <memory>
+
+/*
+    the operator on the tiles of M blocks of K samples, K = M (the matrix of the paper), 2M and 4M:
+    a longer block amortizes the transposes and the recursive doubling of each section over M*K samples,
+    while the tile of K vectors still has to stay in registers.
+    the 2nd and 12th order filters of example/filter.cpp on a trunk that fits in L2.
+ */
+
+// the sections of example/filter.cpp, the first N are taken
+const double sections[6][5] = {1,-0.5,0.25,-0.75,0.6
+                              ,1,0.5,0.7,0.9,0.1
+                              ,1,-0.2,0.2,0.3,0.9
+                              ,1,-0.4,0.5,0.5,0.1
+                              ,1,-0.25,-0.3,0.15,0.7
+                              ,1,0.12,0.23,0.31,0.8
+                              };
+
+template<typename V, int N, int R> void register_tile(const char* vec, long len) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    // R: rows of the tile in units of M
+    constexpr int K = R*V::size();
+
+    std::string name = std::string("tile/K:") + std::to_string(R) + "M/" + vec + "/order:" + std::to_string(2*N);
+
+    register_benchmark(name, len, 2*sizeof(T), [](long len, Counters&) -> Run {
+        T coefs[N][5], inits[N][4] = {};
+        for (auto i=0; i<N; i++) for (auto k=0; k<5; k++) coefs[i][k] = sections[i][k];
+
+        auto F = std::make_shared<Filter<T,N,V,IccTables::lazy,K>>(coefs, inits);
+        auto in = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len);
+
+        // a signal that keeps away from denormals
+        for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+        return [=]() {
+            (*F)(in->begin(), in->end(), out->begin());
+        };
+    });
+};
+
+template<typename V> void register_rows(const char* vec) {
+    const long len = 1 << 15;
+
+    register_tile<V,1,1>(vec, len);
+    register_tile<V,1,2>(vec, len);
+    register_tile<V,1,4>(vec, len);
+    register_tile<V,6,1>(vec, len);
+    register_tile<V,6,2>(vec, len);
+    register_tile<V,6,4>(vec, len);
+};
+
+static int registered = []() {
+    register_rows<Vec4f>("Vec4f");
+    register_rows<Vec8f>("Vec8f");
+    register_rows<Vec16f>("Vec16f");
+    register_rows<Vec2d>("Vec2d");
+    register_rows<Vec4d>("Vec4d");
+    register_rows<Vec8d>("Vec8d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
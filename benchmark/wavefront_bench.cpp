@@ -0,0 +1,77 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <cmath>
+#include <memory>
+
+/*
+    the operator against cascaded_wavefront (the sections pipelined over N tiles in flight) in cycles/sample:
+    operator: the tile through section 0, then section 1 ..., each section waits on the chains of zic and icc of the one before.
+    wavefront: the section i on the tile t-i, the chains of neighbouring sections overlap, for orders 4 to 32 on a trunk in L2.
+    the peak of the FMA ports is reached when cycles/sample stops growing faster than the number of sections.
+ */
+
+// stable sections with poles of radius 0.9 spread over the upper half plane
+template<typename T, int N> void make_coeffs(T (&coefs)[N][5], T (&inits)[N][4]) {
+    const double r = 0.9, pi = 3.14159265358979323846;
+
+    for (auto i=0; i<N; i++) {
+        double theta = pi*(i + 0.5)/N;
+
+        coefs[i][0] = 1;
+        coefs[i][1] = 0.5;
+        coefs[i][2] = 0.25;
+        coefs[i][3] = 2*r*std::cos(theta);
+        coefs[i][4] = -r*r;
+
+        for (auto k=0; k<4; k++) inits[i][k] = 0;
+    }
+};
+
+template<typename V, int N> void register_wavefront(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const char* options[] = {"operator", "wavefront"};
+    const long len = 1 << 15;
+
+    for (auto op=0; op<2; op++) {
+
+        std::string name = std::string("wavefront/") + options[op] + "/" + vec + "/order:" + std::to_string(2*N);
+
+        register_benchmark(name, len, 2*sizeof(T), [op](long len, Counters&) -> Run {
+            T coefs[N][5], inits[N][4];
+            make_coeffs(coefs, inits);
+
+            auto F = std::make_shared<Filter<T,N,V>>(coefs, inits);
+            auto in = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len);
+
+            // a signal that keeps away from denormals
+            for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+            return [=]() {
+                if (op == 0) (*F)(in->begin(), in->end(), out->begin());
+                if (op == 1) F->cascaded_wavefront(in->begin(), in->end(), out->begin());
+            };
+        });
+    }
+};
+
+// filter orders 4, 12, 16, 24, 32
+template<typename V> void register_orders(const char* vec) {
+    register_wavefront<V,2>(vec);
+    register_wavefront<V,6>(vec);
+    register_wavefront<V,8>(vec);
+    register_wavefront<V,12>(vec);
+    register_wavefront<V,16>(vec);
+};
+
+static int registered = []() {
+    register_orders<Vec4f>("Vec4f");
+    register_orders<Vec8f>("Vec8f");
+    register_orders<Vec16f>("Vec16f");
+    register_orders<Vec2d>("Vec2d");
+    register_orders<Vec4d>("Vec4d");
+    register_orders<Vec8d>("Vec8d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
@@ -0,0 +1,69 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <memory>
+
+/*
+    the operator and option 1 on the logical vectors of 1, 2 and 4 native registers (WideVec<V,G>), i.e., M = G*V::size()
+    lanes: more independent chains of FMA in ZIC_T and ICC_T and a longer block per lane, against G times the registers
+    of a matrix and one more level of recursive doubling per doubling. The fastest logical width depends on the CPU.
+    the 2nd and 12th order filters of example/filter.cpp on a trunk that fits in L2.
+ */
+
+// the sections of example/filter.cpp, the first N are taken
+const double sections[6][5] = {1,-0.5,0.25,-0.75,0.6
+                              ,1,0.5,0.7,0.9,0.1
+                              ,1,-0.2,0.2,0.3,0.9
+                              ,1,-0.4,0.5,0.5,0.1
+                              ,1,-0.25,-0.3,0.15,0.7
+                              ,1,0.12,0.23,0.31,0.8
+                              };
+
+template<typename W, int N> void register_width(const char* vec, const char* width, long len) {
+    using T = decltype(std::declval<W>().extract(0));
+
+    const char* options[] = {"option3", "option1"};
+
+    for (auto op=0; op<2; op++) {
+
+        std::string name = std::string("width/") + options[op] + "/" + vec + "/G:" + width + "/order:" + std::to_string(2*N);
+
+        register_benchmark(name, len, 2*sizeof(T), [op](long len, Counters&) -> Run {
+            T coefs[N][5], inits[N][4] = {};
+            for (auto i=0; i<N; i++) for (auto k=0; k<5; k++) coefs[i][k] = sections[i][k];
+
+            auto F = std::make_shared<Filter<T,N,W>>(coefs, inits);
+            auto in = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len);
+
+            // a signal that keeps away from denormals
+            for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+            return [=]() {
+                if (op == 0) (*F)(in->begin(), in->end(), out->begin());
+                if (op == 1) F->cascaded_option1(in->begin(), in->end(), out->begin());
+            };
+        });
+    }
+};
+
+template<typename V, int N> void register_widths(const char* vec) {
+    const long len = 1 << 15;
+
+    register_width<V,N>(vec, "1", len);
+    register_width<WideVec<V,2>,N>(vec, "2", len);
+    register_width<WideVec<V,4>,N>(vec, "4", len);
+};
+
+template<typename V> void register_orders(const char* vec) {
+    register_widths<V,1>(vec);
+    register_widths<V,6>(vec);
+};
+
+static int registered = []() {
+    register_orders<Vec4f>("Vec4f");
+    register_orders<Vec8f>("Vec8f");
+    register_orders<Vec2d>("Vec2d");
+    register_orders<Vec4d>("Vec4d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
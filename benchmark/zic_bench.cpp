@@ -0,0 +1,68 @@
+#include "recursive_filter.h"
+#include "benchmark.h"
+#include <memory>
+
+/*
+    block filtering (option 1) by the two algorithms of the particular part on short buffers of real-time processing:
+    toeplitz: ZIC_NT, M FMAs over the columns of H per vector.
+    rd: ZIC_NT_RD, the FIR part and log_2(M) steps of shift and FMA per vector.
+    the 2nd and 12th order filters of example/filter.cpp at M=4/8/16 (and 2/4/8 for double).
+ */
+
+// the sections of example/filter.cpp, the first N are taken
+const double sections[6][5] = {1,-0.5,0.25,-0.75,0.6
+                              ,1,0.5,0.7,0.9,0.1
+                              ,1,-0.2,0.2,0.3,0.9
+                              ,1,-0.4,0.5,0.5,0.1
+                              ,1,-0.25,-0.3,0.15,0.7
+                              ,1,0.12,0.23,0.31,0.8
+                              };
+
+// buffers of real-time processing, and one that fits in L1
+const long lengths[] = {64, 256, 4096};
+
+template<typename V, int N> void register_zic(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const char* options[] = {"toeplitz", "rd"};
+
+    for (auto len: lengths) {
+        for (auto op=0; op<2; op++) {
+
+            std::string name = std::string("zic/") + options[op] + "/" + vec + "/order:" + std::to_string(2*N) + "/len:" + std::to_string(len);
+
+            register_benchmark(name, len, 2*sizeof(T), [op](long len, Counters&) -> Run {
+                T coefs[N][5], inits[N][4] = {};
+                for (auto i=0; i<N; i++) for (auto k=0; k<5; k++) coefs[i][k] = sections[i][k];
+
+                auto F = std::make_shared<Filter<T,N,V>>(coefs, inits);
+                auto in = std::make_shared<std::vector<T>>(len), out = std::make_shared<std::vector<T>>(len);
+
+                // a signal that keeps away from denormals
+                for (long n=0; n<len; n++) (*in)[n] = T(n%17 - 8);
+
+                return [=]() {
+                    if (op == 0) F->cascaded_option1(in->begin(), in->end(), out->begin());
+                    if (op == 1) F->template cascaded_option1<ZicAlgorithm::rd>(in->begin(), in->end(), out->begin());
+                };
+            });
+        }
+    }
+};
+
+template<typename V> void register_orders(const char* vec) {
+    register_zic<V,1>(vec);
+    register_zic<V,6>(vec);
+};
+
+static int registered = []() {
+    register_orders<Vec4f>("Vec4f");
+    register_orders<Vec8f>("Vec8f");
+    register_orders<Vec16f>("Vec16f");
+    register_orders<Vec2d>("Vec2d");
+    register_orders<Vec4d>("Vec4d");
+    register_orders<Vec8d>("Vec8d");
+    return 0;
+}();
+
+BENCHMARK_MAIN()
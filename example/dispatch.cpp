@@ -0,0 +1,50 @@
+#include "recursive_filter/dispatch.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/*
+    runtime dispatch: the kernels in dispatch_sse.cpp, dispatch_avx2.cpp and dispatch_avx512.cpp are compiled
+    with the flags of their own instruction set, and this translation unit with the baseline flags only.
+ */
+
+using T = float;
+
+int main(){
+
+    // filter parameters:
+    constexpr int L = 12; // order of filter
+    // array of coefficients and initial conditions
+    T inits[L/2][4] = {0.2,0.3,0.4,0.5
+                      ,0.5,0.7,0.9,3
+                      ,-2,2.1,3,9
+                      ,2.2,2.3,0.5,0.3
+                      ,-2,-3,5,7
+                      ,2,3,1,8
+                      };
+    T coefs[L/2][5] = {1,-0.5,0.25,-0.75,0.6
+                      ,1,0.5,0.7,0.9,0.1
+                      ,1,-0.2,0.2,0.3,0.9
+                      ,1,-0.4,0.5,0.5,0.1
+                      ,1,-0.25,-0.3,0.15,0.7
+                      ,1,0.12,0.23,0.31,0.8
+                      };
+
+    // 10.24M samples
+    static const int vector_size = 10240000;
+    // input: an equal-size impulse response
+    std::vector<T> in(vector_size, 0), out(vector_size);
+    in[0] = 1;
+
+    DispatchFilter<T,L/2> F(coefs,inits);
+    auto start = std::chrono::high_resolution_clock::now();
+
+    F(in.data(),in.data()+in.size(),out.data());
+
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    std::cout << F.isa() << ": " << std::chrono::duration_cast<std::chrono::nanoseconds>(finish-start).count() << "ns\n";
+
+    return 0;
+
+}
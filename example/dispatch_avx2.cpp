@@ -0,0 +1,5 @@
+// kernel of the runtime dispatch example, see example/dispatch.cpp
+#include "recursive_filter/dispatch_kernel.h"
+
+RF_INSTANTIATE_KERNEL(float, 6)
+RF_INSTANTIATE_KERNEL(double, 6)
@@ -23,12 +23,13 @@ int main(){
                       ,-2,-3,5,7
                       ,2,3,1,8
                       };
-    T coefs[L/2][5] = {-0.5,0.25,-0.75,0.6
-                      ,0.5,0.7,0.9,0.1
-                      ,-0.2,0.2,0.3,0.9
-                      ,-0.4,0.5,0.5,0.1
-                      ,-0.25,-0.3,0.15,0.7
-                      ,0.12,0.23,0.31,0.8
+    // each row: b0, b1, b2, a1, a2
+    T coefs[L/2][5] = {1,-0.5,0.25,-0.75,0.6
+                      ,1,0.5,0.7,0.9,0.1
+                      ,1,-0.2,0.2,0.3,0.9
+                      ,1,-0.4,0.5,0.5,0.1
+                      ,1,-0.25,-0.3,0.15,0.7
+                      ,1,0.12,0.23,0.31,0.8
                       };
 
     // 1.024M samples
@@ -44,7 +45,7 @@ int main(){
     // auto r = F.cascaded_option1(in.begin(),in.end(),out.begin());
     // auto r = F.cascaded_option2(in.begin(),in.end(),out.begin());
     // auto r = F.cascaded_option3(in.begin(),in.end(),out.begin());
-    auto r = F(in.begin(),in.end(),out.begin());
+    [[maybe_unused]] auto r = F(in.begin(),in.end(),out.begin());
 
     auto finish = std::chrono::high_resolution_clock::now();
 
@@ -0,0 +1,63 @@
+#include "recursive_filter.h"
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+/*
+    sizeof report of the state of the filter for each policy of the tables of icc (see IccTables) and each SIMD vector:
+    per section (zic, icc and the second order core), per 12th order Filter, and for a bank of 1000 such filters,
+    against the caches of the host.
+ */
+
+// order 12, i.e., 6 sections
+constexpr int N = 6;
+
+// number of filters in the bank
+constexpr int channels = 1000;
+
+const char* policy_name(const IccTables p) {
+    const char* names[] = {"rd", "rd2", "mm", "lazy"};
+    return names[int(p)];
+};
+
+// the smallest cache holding the bank, or memory
+std::string fits(const double bytes) {
+    const long levels[] = {sysconf(_SC_LEVEL1_DCACHE_SIZE), sysconf(_SC_LEVEL2_CACHE_SIZE), sysconf(_SC_LEVEL3_CACHE_SIZE)};
+
+    for (auto l=0; l<3; l++) if (levels[l] > 0 && bytes <= levels[l]) return "L" + std::to_string(l+1);
+
+    return "DRAM";
+};
+
+template<typename V, IccTables P> void report(const char* vec) {
+    using T = decltype(std::declval<V>().extract(0));
+
+    const size_t zic = sizeof(ZeroInitCond<V>), icc = sizeof(InitCondCorc<V,P>), core = sizeof(IirCoreOrderTwo<V,P>);
+    const size_t filter = sizeof(Filter<T,N,V,P>);
+    const double bank = double(filter)*channels;
+
+    std::printf("%-8s %-6s %10zu %10zu %10zu %12zu %14.1f %6s\n", vec, policy_name(P), zic, icc, core, filter, bank/1024, fits(bank).c_str());
+};
+
+template<typename V> void report_all(const char* vec) {
+    report<V, IccTables::rd>(vec);
+    report<V, IccTables::rd2>(vec);
+    report<V, IccTables::mm>(vec);
+    report<V, IccTables::lazy>(vec);
+};
+
+int main(){
+
+    std::printf("L1d: %ld KiB, L2: %ld KiB, L3: %ld KiB\n", sysconf(_SC_LEVEL1_DCACHE_SIZE)/1024, sysconf(_SC_LEVEL2_CACHE_SIZE)/1024, 
+                sysconf(_SC_LEVEL3_CACHE_SIZE)/1024);
+    std::printf("%-8s %-6s %10s %10s %10s %12s %14s %6s\n", "vector", "tables", "zic [B]", "icc [B]", "core [B]", "order 12 [B]", "1000 ch [KiB]", "fits");
+
+    report_all<Vec4f>("Vec4f");
+    report_all<Vec8f>("Vec8f");
+    report_all<Vec16f>("Vec16f");
+    report_all<Vec2d>("Vec2d");
+    report_all<Vec4d>("Vec4d");
+    report_all<Vec8d>("Vec8d");
+
+    return 0;
+}
@@ -1,7 +1,17 @@
+#include "recursive_filter/simd_vector.h"
+#include "recursive_filter/aligned_allocator.h"
 #include "recursive_filter/shift_reg.h"
 #include "recursive_filter/zero_init_condition.h"
 #include "recursive_filter/init_cond_correction.h"
 #include "recursive_filter/permuteV.h"
+#include "recursive_filter/wide_vector.h"
 #include "recursive_filter/second_order_cores.h"
 #include "recursive_filter/series.h"
+#include "recursive_filter/fused_series.h"
+#include "recursive_filter/state_transition.h"
 #include "recursive_filter/filter.h"
+#include "recursive_filter/reducers.h"
+#include "recursive_filter/dynamic_filter.h"
+#include "recursive_filter/multi_channel.h"
+#include "recursive_filter/dispatch.h"
+#include "recursive_filter/planner.h"
@@ -0,0 +1,58 @@
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H 1
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/*
+    allocator of buffers aligned to A bytes for the streaming mode of Filter (aligned loads and non-temporal stores of
+    whole vectors), A=64 (a cache line, and the size of the widest vector) by default. With A of 2MB, the buffer is 
+    backed by transparent huge pages where the kernel allows (madvise on linux), which saves the misses of TLB when 
+    the trunks are streamed from DRAM.
+ */
+template<typename T, std::size_t A = 64> struct AlignedAllocator{
+
+    using value_type = T;
+
+    template<typename U> struct rebind { 
+        using other = AlignedAllocator<U, A>; 
+    };
+
+    AlignedAllocator(){};
+
+    template<typename U> AlignedAllocator(const AlignedAllocator<U, A>&){};
+
+    inline T* allocate(const std::size_t n) {
+        // aligned_alloc takes a size of multiple of the alignment
+        const std::size_t bytes = (n*sizeof(T) + A - 1)/A*A;
+
+        void* p = std::aligned_alloc(A, bytes);
+
+        if (!p) throw std::bad_alloc();
+
+        #if defined(__linux__) && defined(MADV_HUGEPAGE)
+            if constexpr (A >= (2 << 20)) madvise(p, bytes, MADV_HUGEPAGE);
+        #endif
+
+        return static_cast<T*>(p);
+    };
+
+    inline void deallocate(T* p, std::size_t) {
+        std::free(p);
+    };
+
+    template<typename U> bool operator==(const AlignedAllocator<U, A>&) const { return true; };
+    template<typename U> bool operator!=(const AlignedAllocator<U, A>&) const { return false; };
+};
+
+// buffers aligned to the cache line, and to the huge page of 2MB
+template<typename T> using HugePageAllocator = AlignedAllocator<T, 2 << 20>;
+
+template<typename T> using aligned_vector = std::vector<T, AlignedAllocator<T>>;
+template<typename T> using huge_page_vector = std::vector<T, HugePageAllocator<T>>;
+
+#endif // header guard
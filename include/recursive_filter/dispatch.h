@@ -0,0 +1,90 @@
+#ifndef DISPATCH_H
+#define DISPATCH_H 1
+
+#include <memory>
+#include "instrset.h"
+
+/*
+
+    Runtime dispatch of the instruction set: one binary carries the kernels of Filter compiled separately for
+    SSE (Vec4f/Vec2d), AVX2 (Vec8f/Vec4d) and AVX512 (Vec16f/Vec8d), and binds the widest one supported by the cpu.
+
+    Each kernel lives in its own translation unit that includes "recursive_filter/dispatch_kernel.h", is compiled
+    with the flags of its instruction set and a distinct VCL_NAMESPACE, and instantiates the (T, N) it needs, e.g.,
+
+        // filter_avx2.cpp, compiled with -mavx2 -mfma -DVCL_NAMESPACE=vcl_avx2
+        #include "recursive_filter/dispatch_kernel.h"
+        RF_INSTANTIATE_KERNEL(float, 6)
+
+    and the same for SSE (-msse2 -DVCL_NAMESPACE=vcl_sse) and AVX512 (-mavx512f -mfma -DVCL_NAMESPACE=vcl_avx512).
+    See example/dispatch.cpp.
+
+ */
+
+
+// interface of Filter compiled for one instruction set
+template<typename T> class FilterKernel{
+
+    public:
+
+        virtual ~FilterKernel(){};
+
+        // higher order filter of cascaded option 3, see Filter::operator()
+        virtual T* operator()(const T* first, const T* last, T* d_first) = 0;
+
+        // read and overwrite the pre-conditions, inits[i] = [x_{-1}, x_{-2}, y_{-1}, y_{-2}] of the i-th section
+        virtual void get_inits(T (*inits)[4]) = 0;
+        virtual void set_inits(const T (*inits)[4]) = 0;
+
+        // name of the instruction set
+        virtual const char* isa() const = 0;
+};
+
+// factories of the kernels, defined in the translation unit of each instruction set
+template<typename T, int N> std::unique_ptr<FilterKernel<T>> make_filter_kernel_sse(const T (&coeffs)[N][5], const T (&inits)[N][4]);
+template<typename T, int N> std::unique_ptr<FilterKernel<T>> make_filter_kernel_avx2(const T (&coeffs)[N][5], const T (&inits)[N][4]);
+template<typename T, int N> std::unique_ptr<FilterKernel<T>> make_filter_kernel_avx512(const T (&coeffs)[N][5], const T (&inits)[N][4]);
+
+// the same interface as Filter, bound to the widest kernel supported by the cpu at construction.
+template<typename T, int N> class DispatchFilter{
+
+    private:
+
+        std::unique_ptr<FilterKernel<T>> _K;
+
+        // detect the instruction set once: 9 or above: AVX512, 8: AVX2, otherwise SSE
+        static inline int _instrset() {
+            static const int iset = instrset_detect();
+            return iset;
+        };
+
+    public:
+
+        // Parameterized constructor, initialize higher order filter by array of coefficients and pre-conditions
+        DispatchFilter(const T (&coeffs)[N][5], const T (&inits)[N][4]) {
+
+            if (_instrset() >= 9) _K = make_filter_kernel_avx512<T,N>(coeffs, inits);
+            else if (_instrset() >= 8 && hasFMA3()) _K = make_filter_kernel_avx2<T,N>(coeffs, inits);
+            else _K = make_filter_kernel_sse<T,N>(coeffs, inits);
+        };
+
+        // operator, higher order filter of cascaded option 3.
+        inline T* operator()(const T* first, const T* last, T* d_first) {
+            return (*_K)(first, last, d_first);
+        };
+
+        inline void get_inits(T (&inits)[N][4]) {
+            _K->get_inits(inits);
+        };
+
+        inline void set_inits(const T (&inits)[N][4]) {
+            _K->set_inits(inits);
+        };
+
+        // name of the bound instruction set
+        inline const char* isa() const {
+            return _K->isa();
+        };
+};
+
+#endif // header guard
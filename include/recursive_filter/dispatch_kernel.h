@@ -0,0 +1,61 @@
+#ifndef DISPATCH_KERNEL_H
+#define DISPATCH_KERNEL_H 1
+
+// include once per kernel translation unit only, compiled with the flags of one instruction set (see dispatch.h).
+
+#include "simd_vector.h"
+#include "filter.h"
+#include "dispatch.h"
+
+// kernel of Filter for the instruction set of this translation unit
+template<typename T, int N, typename V> class FilterKernelImpl: public FilterKernel<T>{
+
+    private:
+
+        Filter<T,N,V> _F;
+
+    public:
+
+        FilterKernelImpl(const T (&coeffs)[N][5], const T (&inits)[N][4]): _F(coeffs, inits){};
+
+        T* operator()(const T* first, const T* last, T* d_first) override {
+            return _F(first, last, d_first);
+        };
+
+        void get_inits(T (*inits)[4]) override {
+            _F.get_inits(*reinterpret_cast<T (*)[N][4]>(inits));
+        };
+
+        void set_inits(const T (*inits)[4]) override {
+            _F.set_inits(*reinterpret_cast<const T (*)[N][4]>(inits));
+        };
+
+        const char* isa() const override {
+            #if INSTRSET >= 9
+                return "AVX512";
+            #elif INSTRSET >= 7
+                return "AVX2";
+            #else
+                return "SSE";
+            #endif
+        };
+};
+
+// the factory named after the instruction set of this translation unit
+#if INSTRSET >= 9
+    #define RF_MAKE_FILTER_KERNEL make_filter_kernel_avx512
+#elif INSTRSET >= 7
+    #define RF_MAKE_FILTER_KERNEL make_filter_kernel_avx2
+#else
+    #define RF_MAKE_FILTER_KERNEL make_filter_kernel_sse
+#endif
+
+template<typename T, int N> std::unique_ptr<FilterKernel<T>> RF_MAKE_FILTER_KERNEL(const T (&coeffs)[N][5], const T (&inits)[N][4]) {
+    return std::make_unique<FilterKernelImpl<T,N,simd_vector_t<T>>>(coeffs, inits);
+};
+
+// explicit instantiation of the kernel for data type T and N sections
+#define RF_INSTANTIATE_KERNEL(T, N) \
+    template std::unique_ptr<FilterKernel<T>> RF_MAKE_FILTER_KERNEL<T,N>(const T (&)[N][5], const T (&)[N][4]);
+
+#endif // header guard
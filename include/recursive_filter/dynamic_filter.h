@@ -0,0 +1,132 @@
+#ifndef DYNAMIC_FILTER_H
+#define DYNAMIC_FILTER_H 1
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+#include "simd_vector.h"
+#include "second_order_cores.h"
+#include "permuteV.h"
+
+// state of the sections of DynamicFilter, s[i] = [x_{-1}, x_{-2}, y_{-1}, y_{-2}] of the i-th section as FilterState.
+template<typename T> struct DynamicFilterState {
+    std::vector<std::array<T,4>> s;
+};
+
+/*
+    cascaded second order filter whose number of sections is given at run time, e.g., designed from a configuration.
+    The cores are kept in one contiguous vector and walked by a loop instead of the recursive templates over the tuple
+    of Series, and the data are filtered by multi-block filtering (option 3) as the operator of Filter.
+ */
+template<typename T, typename V = simd_vector_t<T>> class DynamicFilter{
+
+    // M: length of SIMD vector.
+    constexpr static int M = V::size();
+
+    private:
+
+        // second order cores of the sections
+        std::vector<IirCoreOrderTwo<V>> _cores;
+
+        // pass one register tile (len valid samples, zero padded) through all cores in place
+        inline void _series_option3_inplace(std::array<V,M>& x, const int len) {
+            for (auto& c: _cores) c.option3_middle_inplace(x, len);
+        };
+
+        // filter the remainder (less than M*M samples) in a zero padded matrix by option 3, the same as Filter.
+        template<typename InputIt, typename OutputIt> inline OutputIt _remainder_option3(InputIt first, InputIt last, OutputIt d_first) {
+            return _remainder_tile<V,M>(first, last, d_first, [this](std::array<V,M>& x, const int len) { _series_option3_inplace(x, len); });
+        };
+
+    public:
+
+        // default constructor
+        DynamicFilter(){};
+
+        // Parameterized constructor, initialize n sections by the array of coefficients and pre-conditions in row major, as Filter.
+        DynamicFilter(const T (*coeffs)[5], const T (*inits)[4], const int n) {
+
+            _cores.reserve(n);
+
+            for (auto i=0; i<n; i++) _cores.emplace_back(coeffs[i], inits[i]);
+        };
+
+        // Overloaded constructor of zero pre-conditions
+        DynamicFilter(const T (*coeffs)[5], const int n) {
+
+            const T zeros[4] = {0};
+
+            _cores.reserve(n);
+
+            for (auto i=0; i<n; i++) _cores.emplace_back(coeffs[i], zeros);
+        };
+
+        // number of sections
+        inline int sections() const {
+            return _cores.size();
+        };
+
+        // read the pre-conditions of all sections, inits[i] = [x_{-1}, x_{-2}, y_{-1}, y_{-2}] as in the constructor
+        inline void get_inits(T (*inits)[4]) {
+            for (size_t i=0; i<_cores.size(); i++) _cores[i].get_inits(inits[i]);
+        };
+
+        // overwrite the pre-conditions of all sections
+        inline void set_inits(const T (*inits)[4]) {
+            for (size_t i=0; i<_cores.size(); i++) _cores[i].set_inits(inits[i]);
+        };
+
+        // snapshot the state of all sections
+        inline DynamicFilterState<T> get_state() {
+            DynamicFilterState<T> state;
+
+            state.s.resize(_cores.size());
+            for (size_t i=0; i<_cores.size(); i++) _cores[i].get_inits(state.s[i].data());
+
+            return state;
+        };
+
+        // restore a state from get_state of a filter of the same sections, e.g., roll back, or continue a stream handed over.
+        // the sections beyond the state, if any, are kept.
+        inline void set_state(const DynamicFilterState<T>& state) {
+            for (size_t i=0; i<std::min(_cores.size(), state.s.size()); i++) _cores[i].set_inits(state.s[i].data());
+        };
+
+        // clear the state of all sections to zero pre-conditions
+        inline void reset() {
+            const T zeros[4] = {0};
+
+            for (auto& c: _cores) c.set_inits(zeros);
+        };
+
+        // operator, higher order filter of cascaded option 3 by one register tile, the same as the operator of Filter.
+        template<typename InputIt, typename OutputIt> inline OutputIt operator()(InputIt first, InputIt last, OutputIt d_first) {
+            std::array<V,M> x;
+
+            while (first <= last - M*M){
+
+                _load_tile(x, first);
+                _series_option3_inplace(x, M*M);
+                _store_tile(x, d_first);
+
+                // iterator += size of one matrix
+                first += M*M;
+                d_first += M*M;
+
+            }
+
+            // the last samples that cannot fill a matrix
+            d_first = _remainder_option3(first, last, d_first);
+
+            return d_first;
+        };
+
+        // streaming block of any length by the operator, see Filter::process.
+        inline void process(std::span<const T> in, std::span<T> out) {
+            (*this)(in.begin(), in.end(), out.begin());
+        };
+
+};
+
+#endif // header guard
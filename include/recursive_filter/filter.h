@@ -1,29 +1,76 @@
 #ifndef FILTER_H
 #define FILTER_H 1
 
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+#include "simd_vector.h"
 #include "series.h"
 #include "permuteV.h"
+#include "state_transition.h"
+
+// compact state of N cascaded sections, trivially copyable thus can be snapshot, rolled back or handed over between threads.
+// s[i] = [x_{-1}, x_{-2}, y_{-1}, y_{-2}] of the i-th section, the same as the inits of Filter. Value initialized to zero state.
+template<typename T, int N> struct FilterState {
+    T s[N][4] = {};
+};
+
+// extension of the signal at both edges in forward-backward filtering: none, odd (point symmetric) or even (mirror symmetric).
+enum class PadType { none, odd, even };
 
 // real function to user: use the cascaded second order filter to process a trunk of data.
-template<typename T, int N> class Filter{ 
-    
-    // select the vector length and type based on the requested instruction set and the type T
-    #if INSTRSET >= 9  // AVX512
-        using V = typename std::conditional<std::is_same<T, float>::value, Vec16f, Vec8d>::type;
-    #elif INSTRSET >= 7  // AVX2
-        using V = typename std::conditional<std::is_same<T, float>::value, Vec8f, Vec4d>::type;
-    #else // SSE
-        using V = typename std::conditional<std::is_same<T, float>::value, Vec4f, Vec2d>::type;
-    #endif
+// V: SIMD vector, selected by the instruction set of the translation unit by default (see dispatch.h for runtime selection).
+// P: tables kept by the icc of each section (see IccTables), e.g., IccTables::rd for a bank of many filters.
+// K: rows of the register tile of the operator, i.e., M lanes each holding a block of K samples (K = M, 2M, 4M ...). A longer 
+//    block amortizes the transposes and the recursive doubling of each section over M*K samples. The operator, process and
+//    cascaded_parallel take any K, the other paths of option 3 work on M by M matrices, thus require K = M.
+template<typename T, int N, typename V = simd_vector_t<T>, IccTables P = IccTables::lazy, int K = V::size()> class Filter{ 
 
     // M: length of SIMD vector.
     constexpr static int M = V::size();
 
+    // the register tile of the operator, X^T of M blocks of K samples, i.e., sample s at x[s%K][s/K]
+    using tile_t = std::array<V,K>;
+
     private:
 
         // define state of series from array of coefficients and initial conditions. 
-        using Series_t = decltype(series_from_coeffs<T,V>(std::declval<const T (&)[N][5]>(), std::declval<const T (&)[N][4]>())); 
+        using Series_t = decltype(series_from_coeffs<T,V,P,K>(std::declval<const T (&)[N][5]>(), std::declval<const T (&)[N][4]>())); 
         Series_t _S;
+
+        // keep the coefficients for the state transition in parallel filtering, in double for the mixed precision constructor
+        double _coeffs[N][5];
+
+        // offset of the next sample kept by decimate in the next trunk, i.e., the outputs [0, _skip) of the next trunk are discarded.
+        int _skip = 0;
+
+        // filter the remainder (less than M*K samples) in a zero padded tile by option 3, in the register tile x. 
+        template<typename InputIt, typename OutputIt> inline OutputIt _remainder_option3(InputIt first, InputIt last, OutputIt d_first) {
+            return _remainder_tile<V,K>(first, last, d_first, [this](tile_t& x, const int len) { _S.series_option3_inplace(x, len); });
+        };
+
+        // add the response of the current pre-conditions to zero input onto a trunk of filtered data by option 3, i.e., the homogeneous part.
+        template<typename OutputIt> inline OutputIt _add_homogeneous(OutputIt first, OutputIt last) {
+            tile_t x;
+            alignas(64) T y[M*K];
+
+            while (first < last) {
+                const int len = std::min<long>(last - first, M*K);
+
+                x.fill(V(0));
+                _S.series_option3_inplace(x, len);
+                _store_tile(x, y, len);
+
+                for (auto n=0; n<len; n++) *(first + n) += y[n];
+
+                first += len;
+            }
+
+            return first;
+        };
         
     public:
 
@@ -31,7 +78,53 @@ template<typename T, int N> class Filter{
         Filter(){};
 
         // Parameterized constructor, initialize higher order filter by array of coefficients and pre-conditions
-        Filter(const T (&coeffs)[N][5], const T (&inits)[N][4]): _S(series_from_coeffs<T,V>(coeffs, inits)){}; 
+        Filter(const T (&coeffs)[N][5], const T (&inits)[N][4]): _S(series_from_coeffs<T,V,P,K>(coeffs, inits)){
+
+            std::copy(&coeffs[0][0], &coeffs[0][0] + N*5, &_coeffs[0][0]);
+        }; 
+
+        /* 
+            Overloaded constructor of mixed precision, e.g., Filter<float,N> by coefficients and pre-conditions in double.
+            the coefficients are never rounded before the pre-computations (A, B, H and the powers of C in recursive doubling), 
+            which are done in double and rounded to T once, and the filtering of the matrices stays in T. The recursion of
+            ZIC_T takes a_1 and a_2 as the sum of two values in T (see ZIC_T_kernel), thus zic sees the same poles in double
+            as the powers of C in icc. The states are samples and outputs of the matrices, which are exact in T.
+         */
+        Filter(const double (&coeffs)[N][5], const double (&inits)[N][4]) requires (!std::is_same_v<T, double>)
+            : _S(series_from_coeffs<double,V,P,K>(coeffs, inits)){
+
+            std::copy(&coeffs[0][0], &coeffs[0][0] + N*5, &_coeffs[0][0]);
+        }; 
+
+        // read the pre-conditions of all sections, inits[i] = [x_{-1}, x_{-2}, y_{-1}, y_{-2}] as in the constructor
+        inline void get_inits(T (&inits)[N][4]) {
+            _S.get_inits(inits);
+        };
+
+        // overwrite the pre-conditions of all sections
+        inline void set_inits(const T (&inits)[N][4]) {
+            _S.set_inits(inits);
+        };
+
+        // snapshot the state of all sections
+        inline FilterState<T,N> get_state() {
+            FilterState<T,N> state;
+
+            _S.get_inits(state.s);
+
+            return state;
+        };
+
+        // restore a state from get_state, e.g., roll back, or continue a stream handed over by another filter
+        inline void set_state(const FilterState<T,N>& state) {
+            _S.set_inits(state.s);
+        };
+
+        // clear the state of all sections to zero pre-conditions, and the offset of decimate
+        inline void reset() {
+            set_state(FilterState<T,N>{});
+            _skip = 0;
+        };
 
 
         /* 
@@ -41,17 +134,30 @@ template<typename T, int N> class Filter{
             cascaded_option1: block filtering
             cascaded_option2: mixed block and multi-block filtering 
             cascaded_option3: multi-block filtering 
-            operator: multi-block filtering, the same as cascaded_option3.
+            operator: multi-block filtering, the same as cascaded_option3, on the tile of K rows.
+            cascaded_tile: the operator by a selected algorithm of icc.
+            cascaded_wavefront: the operator pipelined across the sections, N tiles in flight.
+            transposed: the operator on data in the tile order, without the transposes.
+            streaming: the operator for trunks from DRAM, aligned and non-temporal.
+            reduce: the operator without output, the outputs are reduced in registers.
+            filter_inplace: the operator in place.
+            decimate: the operator keeping every D-th output.
+            interpolate: the operator on the input upsampled by L with zeros.
+            cascaded_parallel: multi-block filtering of chunks on multiple threads.
+
+            None of them drops samples: the remainder that does not fill a whole vector (or matrix) is processed by 
+            a zero padded matrix (option 3), or by the vector path (option 1) and then the scalar path. The states 
+            are carried over exactly, thus the next call continues the signal seamlessly.
 
          */
 
 
         // filter system filtering scalar 
-        template<typename InputIt, typename OutputIt> inline OutputIt cascaded_scalar(InputIt first, OutputIt last, OutputIt d_first){
+        template<typename InputIt, typename OutputIt> inline OutputIt cascaded_scalar(InputIt first, InputIt last, OutputIt d_first){
 
             while (first <= last - 1){
                
-                *d_first = _S.Series_scalar(*first);
+                *d_first = _S.series_scalar(*first);
 
                 first += 1;
                 d_first += 1;
@@ -62,15 +168,17 @@ template<typename T, int N> class Filter{
 
         };
 
-        // higher order filter of cascaded option 1, block filtering: filtering a vector of data.
-        template<typename InputIt, typename OutputIt> inline OutputIt cascaded_option1(InputIt first, OutputIt last, OutputIt d_first) {
+        // higher order filter of cascaded option 1, block filtering: filtering a vector of data. A: the particular part by the
+        // Toeplitz matrix (ZIC_NT) or in log_2(M) steps (ZIC_NT_RD), see ZicAlgorithm.
+        template<ZicAlgorithm A = ZicAlgorithm::toeplitz, typename InputIt, typename OutputIt> 
+        inline OutputIt cascaded_option1(InputIt first, InputIt last, OutputIt d_first) {
             V x, y;
 
             while (first <= last - M) {
 
                 x.load(&*first);  
                
-                y = _S.series_option1(x);
+                y = _S.template series_option1<A>(x);
 
                 y.store(&*d_first);
 
@@ -79,12 +187,15 @@ template<typename T, int N> class Filter{
                 d_first += M;
             }
 
+            // the last samples that cannot fill a vector
+            d_first = cascaded_scalar(first, last, d_first);
+
             // return the iterator of the last data
             return d_first;
         };
 
         // higher order filter of cascaded option 2, mixed filtering: filtering a matrix of data.
-        template<typename InputIt, typename OutputIt> inline OutputIt cascaded_option2(InputIt first, OutputIt last, OutputIt d_first) {
+        template<typename InputIt, typename OutputIt> inline OutputIt cascaded_option2(InputIt first, InputIt last, OutputIt d_first) {
             std::array<V,M> x, y;
 
             while (first <= last - M*M) {
@@ -100,11 +211,14 @@ template<typename T, int N> class Filter{
                 d_first += M*M;
             }
 
+            // the last vectors that cannot fill a matrix
+            d_first = cascaded_option1(first, last, d_first);
+
             return d_first;
         };
 
         // higher order filter of cascaded option 3, multi-block filtering: filtering a matrix of data.
-        template<typename InputIt, typename OutputIt> inline OutputIt cascaded_option3(InputIt first, OutputIt last, OutputIt d_first) {
+        template<typename InputIt, typename OutputIt> inline OutputIt cascaded_option3(InputIt first, InputIt last, OutputIt d_first) requires (K == M) {
             std::array<V,M> x, y, x_T, y_T;
 
             while (first <= last - M*M){
@@ -123,22 +237,100 @@ template<typename T, int N> class Filter{
 
             }
 
+            // the last samples that cannot fill a matrix
+            d_first = _remainder_option3(first, last, d_first);
+
             return d_first;
         };
 
-        // operator, higher order filter of cascaded option 3.
-        template<typename InputIt, typename OutputIt> inline OutputIt operator()(InputIt first, OutputIt last, OutputIt d_first) {
-            std::array<V,M> x, y, x_T, y_T;
+        // operator, higher order filter of cascaded option 3. One register tile x is transposed and passed through the cores 
+        // by reference, rather than copied into x_T, y_T and y as in cascaded_option3.
+        template<typename InputIt, typename OutputIt> inline OutputIt operator()(InputIt first, InputIt last, OutputIt d_first) {
+            return cascaded_tile<IccAlgorithm::rd>(first, last, d_first);
+        };
+
+        // the operator by the algorithm A of icc (ICC_T, ICC_T_MM or ICC2_T) for the whole matrices, the choices of the planner.
+        template<IccAlgorithm A, typename InputIt, typename OutputIt> inline OutputIt cascaded_tile(InputIt first, InputIt last, OutputIt d_first) {
+            tile_t x;
+
+            while (first <= last - M*K){
+
+                if constexpr (K == M) {
+                    for (auto n=0; n<M; n++) x[n].load(&*(first + n*M));  
+                    _permuteV_inplace(x);
+                } else {
+                    _load_tile(x, first);
+                }
+
+                _S.template series_option3_inplace<A>(x);
+
+                if constexpr (K == M) {
+                    _permuteV_inplace(x);
+                    for (auto n=0; n<M; n++) x[n].store(&*(d_first + n*M));
+                } else {
+                    _store_tile(x, d_first);
+                }
+
+                // iterator += size of one tile
+                first += M*K;
+                d_first += M*K;
+
+            }
+
+            // the last samples that cannot fill a matrix
+            d_first = _remainder_option3(first, last, d_first);
+
+            return d_first;
+        };
+
+        /* 
+            the operator pipelined across the sections (wavefront, see Series::series_option3_wavefront): the section i filters 
+            the tile t-i while the section i+1 filters the tile t-i-1, thus the serial chains of zic and icc of the sections 
+            overlap instead of waiting on each other, at the cost of N tiles in flight in L1 rather than one tile in registers.
+            Pays off for filters of many sections, where the operator is bound by the latency of the chains. The output is the 
+            same as the operator, in and out can be the same buffer (the tile t is loaded before the tile t-N+1 is stored).
+         */
+        template<typename InputIt, typename OutputIt> inline OutputIt cascaded_wavefront(InputIt first, InputIt last, OutputIt d_first) {
+            std::array<tile_t,N> ring;
+
+            // number of whole tiles
+            const long count = (last - first)/(M*K);
+
+            for (long t=0; t<count+N-1; t++) {
+
+                if (t < count) _load_tile(ring[t%N], first + t*M*K);
+
+                _S.series_option3_wavefront(ring, t, count);
+
+                // the tile through the last section
+                if (t >= N-1) _store_tile(ring[(t-N+1)%N], d_first + (t-N+1)*M*K);
+            }
+
+            first += count*M*K;
+            d_first += count*M*K;
+
+            // the last samples that cannot fill a matrix
+            d_first = _remainder_option3(first, last, d_first);
+
+            return d_first;
+        };
+
+        /* 
+            the operator on data in the tile order (see transpose_tiles in permuteV.h): each matrix of M*M samples is stored
+            as X^T, i.e., the sample s of the k-th matrix at first[k*M*M + (s%M)*M + s/M], and the output is written in the 
+            same order, thus both transposes of each matrix are skipped. The last samples that cannot fill a matrix are in
+            the natural order. The state is carried over as the operator, and in and out can be the same buffer.
+         */
+        template<typename InputIt, typename OutputIt> inline OutputIt transposed(InputIt first, InputIt last, OutputIt d_first) requires (K == M) {
+            std::array<V,M> x;
 
             while (first <= last - M*M){
 
                 for (auto n=0; n<M; n++) x[n].load(&*(first + n*M));  
 
-                x_T = _permuteV(x);
-                y_T = _S.series_option3(x_T);
-                y = _permuteV(y_T);
+                _S.series_option3_inplace(x);
                
-                for (auto n=0; n<M; n++) y[n].store(&*(d_first + n*M));
+                for (auto n=0; n<M; n++) x[n].store(&*(d_first + n*M));
 
                 // iterator += size of one matrix
                 first += M*M;
@@ -146,9 +338,354 @@ template<typename T, int N> class Filter{
 
             }
 
+            // the last samples that cannot fill a matrix, in the natural order
+            d_first = _remainder_option3(first, last, d_first);
+
             return d_first;
         };
 
+        /* 
+            the operator for large trunks bound by the bandwidth of DRAM, e.g., in buffers of aligned_vector or huge_page_vector 
+            (aligned_allocator.h): the matrices are loaded by aligned loads, the matrix distance ahead is prefetched (non-temporal,
+            the input is read once), and the outputs are written by non-temporal stores, which skip the read for ownership of 
+            the output lines and keep the cache clean. first and d_first must be aligned to the vector (64 bytes covers all),
+            otherwise the operator is used. Not for trunks that are read again soon from cache, e.g., in place in L2.
+         */
+        inline T* streaming(const T* first, const T* last, T* d_first, const int distance=8) requires (K == M) {
+            std::array<V,M> x;
+
+            if ((reinterpret_cast<uintptr_t>(first) | reinterpret_cast<uintptr_t>(d_first)) % sizeof(V) != 0) {
+                return (*this)(first, last, d_first);
+            }
+
+            while (first <= last - M*M){
+
+                // prefetch the matrix distance ahead, line by line
+                if (last - first > distance*M*M) {
+                    for (size_t b=0; b<M*M*sizeof(T); b+=64) {
+                        _mm_prefetch(reinterpret_cast<const char*>(first + distance*M*M) + b, _MM_HINT_NTA);
+                    }
+                }
+
+                for (auto n=0; n<M; n++) x[n].load_a(first + n*M);  
+
+                _permuteV_inplace(x);
+                _S.series_option3_inplace(x);
+                _permuteV_inplace(x);
+               
+                for (auto n=0; n<M; n++) x[n].store_nt(d_first + n*M);
+
+                // iterator += size of one matrix
+                first += M*M;
+                d_first += M*M;
+
+            }
+
+            // order the non-temporal stores before the following stores
+            _mm_sfence();
+
+            // the last samples that cannot fill a matrix
+            return _remainder_option3(first, last, d_first);
+        };
+
+        /* 
+            output-less operator for the statistics of the filtered signal, e.g., energy, rms, peak (see reducers.h): each
+            matrix Y^T is passed to the reducer r while it stays in registers, thus neither the transpose at the tail nor 
+            the stores of the outputs are done. r is called as r(y_T, len) with the sample s of the matrix at y_T[s%M][s/M].
+            The pre-conditions are carried over as the operator, and the final state is returned.
+         */
+        template<typename InputIt, typename Reducer> inline FilterState<T,N> reduce(InputIt first, InputIt last, Reducer&& r) requires (K == M) {
+            std::array<V,M> x;
+
+            while (first <= last - M*M){
+
+                for (auto n=0; n<M; n++) x[n].load(&*(first + n*M));  
+
+                _permuteV_inplace(x);
+                _S.series_option3_inplace(x);
+
+                r(x, M*M);
+
+                first += M*M;
+            }
+
+            // the last samples that cannot fill a matrix, zero padded
+            const int len = last - first;
+
+            if (len > 0) {
+                for (auto n=0; n<M; n++) {
+                    int k = std::min(std::max(len - n*M, 0), M);
+
+                    if (k > 0) x[n].load_partial(k, &*(first + n*M));  
+                    else x[n] = V(0);
+                }
+
+                _permuteV_inplace(x);
+                _S.series_option3_inplace(x, len);
+
+                r(x, len);
+            }
+
+            return get_state();
+        };
+
+        // filter a trunk of data in place by the operator, each matrix is loaded before it is overwritten.
+        inline void filter_inplace(std::span<T> x) {
+            (*this)(x.begin(), x.end(), x.begin());
+        };
+
+        /* 
+            streaming block of any length, e.g., the buffer of an audio callback, by the operator: in.size() samples are 
+            filtered into out (of at least the same size, in and out can be the same buffer), and the state is carried 
+            to the next block. Nothing is allocated, and the work is bounded by ceil(in.size()/(M*K)) tiles.
+         */
+        inline void process(std::span<const T> in, std::span<T> out) {
+            (*this)(in.begin(), in.end(), out.begin());
+        };
+
+        /* 
+            decimating filter by the operator: every sample is filtered, thus the pre-conditions are carried over exactly, but
+            only every D-th output is stored, counted across the calls (the first output after reset is kept). 
+            1. the sample s of a matrix sits at Y^T[s%M][s/M], thus the kept samples are in the blocks r = _skip (mod gcd(M,D))
+               only, and ICC_T of the last section forwards those blocks (and the last two carrying the pre-conditions).
+            2. the kept samples are read from the blocks of Y^T, the transpose at the tail is skipped, and 1/D of the 
+               outputs are written to d_first.
+            returns the iterator after the last kept output.
+         */
+        template<typename InputIt, typename OutputIt> inline OutputIt decimate(InputIt first, InputIt last, OutputIt d_first, const int D) requires (K == M) {
+            std::array<V,M> x;
+            alignas(64) T buf[M*M];
+
+            if (D == 1) return (*this)(first, last, d_first);
+
+            const int g = std::gcd(M, D);
+
+            while (first <= last - M*M){
+
+                for (auto n=0; n<M; n++) x[n].load(&*(first + n*M));  
+
+                // the first block of Y^T to be kept, none if the next kept sample is beyond this matrix
+                const int row0 = (_skip < M*M) ? _skip % g : M;
+
+                _permuteV_inplace(x);
+                _S.series_option3_rows_inplace(x, row0, g);
+
+                for (auto r=row0; r<M; r+=g) x[r].store(buf + r*M);
+                for (auto s=_skip; s<M*M; s+=D) *d_first++ = buf[(s%M)*M + s/M];
+
+                _skip = ((_skip - M*M) % D + D) % D;
+                first += M*M;
+            }
+
+            // the last samples that cannot fill a matrix, filtered in order into buf
+            const int len = last - first;
+
+            if (len > 0) {
+                _remainder_option3(first, last, buf);
+
+                for (auto s=_skip; s<len; s+=D) *d_first++ = buf[s];
+
+                _skip = ((_skip - len) % D + D) % D;
+            }
+
+            return d_first;
+        };
+
+        /* 
+            interpolating filter by the operator: the low rate samples in [first, last) are upsampled by L, i.e., L-1 zeros are 
+            inserted after each sample, and filtered into L*(last-first) outputs. The zero stuffed input is never formed:
+            the first section computes its particular part from the low rate samples only (ZIC_NT_stuffed), and the others 
+            run option 3 as the operator. The last samples that cannot fill a matrix are stuffed in one matrix on stack.
+            returns the iterator after the last output.
+         */
+        template<typename InputIt, typename OutputIt> inline OutputIt interpolate(InputIt first, InputIt last, OutputIt d_first, const int L) requires (K == M) {
+            std::array<V,M> x;
+
+            // number of outputs, and index of the first output of the current matrix
+            const long len = (last - first)*L;
+            long j = 0;
+
+            while (j <= len - M*M){
+
+                // position of the next low rate sample in the matrix
+                first = _S.series_option3_stuffed(x, first, (L - j%L)%L, L);
+                _permuteV_inplace(x);
+
+                for (auto n=0; n<M; n++) x[n].store(&*(d_first + j + n*M));
+
+                j += M*M;
+            }
+
+            const int rem = len - j;
+
+            if (rem > 0) {
+                T buf[M*M] = {};
+
+                for (auto c=(L - j%L)%L; c<rem; c+=L, ++first) buf[c] = *first;
+                _remainder_option3(buf, buf + rem, d_first + j);
+            }
+
+            return d_first + len;
+        };
+
+        // the state of steady output to a constant input x0, i.e., each section holds the input x0*g_0*...*g_{i-1} and 
+        // the output x0*g_0*...*g_i, where g_i = (b_0+b_1+b_2)/(1-a_1-a_2) is the DC gain of the i-th section.
+        inline FilterState<T,N> steady_state(const T x0) {
+            FilterState<T,N> state;
+            double x = x0;
+
+            for (auto i=0; i<N; i++) {
+                double g = (_coeffs[i][0] + _coeffs[i][1] + _coeffs[i][2])/(1 - _coeffs[i][3] - _coeffs[i][4]);
+
+                state.s[i][0] = state.s[i][1] = x;
+                x *= g;
+                state.s[i][2] = state.s[i][3] = x;
+            }
+
+            return state;
+        };
+
+        /* 
+            zero-phase forward-backward filtering by the operator:
+            1. the signal is extended by pad samples at both edges (3*(2N+1) by default, at most last-first-1), and each pass
+               starts from the steady state of its first sample, which suppresses the transients at the edges.
+            2. forward pass: the left extension, the signal into d_first, and the right extension into a small buffer.
+            3. backward pass in place on d_first: matrices are loaded from the end of the output and reversed inside the 
+               transpose stage (_permuteV_reverse_inplace), thus no reversed copy of the data is written.
+            the pre-conditions of the filter are restored at the end.
+         */
+        template<typename InputIt, typename OutputIt> inline OutputIt filtfilt(InputIt first, InputIt last, OutputIt d_first, 
+                                                                              const PadType padtype=PadType::odd, int pad=3*(2*N+1)) requires (K == M) {
+            const long len = last - first;
+
+            if (len <= 0) return d_first;
+
+            pad = (padtype == PadType::none) ? 0 : std::min<long>(pad, len - 1);
+
+            FilterState<T,N> state = get_state();
+            std::vector<T> ext(pad), ext_y(pad);
+            std::array<V,M> x;
+
+            // step 1 and 2: left extension, signal and right extension
+            for (auto n=0; n<pad; n++) {
+                T mirror = *(first + pad - n);
+                ext[n] = (padtype == PadType::odd) ? 2*(*first) - mirror : mirror;
+            }
+
+            set_state(steady_state(pad > 0 ? ext[0] : *first));
+            if (pad > 0) (*this)(ext.begin(), ext.end(), ext_y.begin());
+            (*this)(first, last, d_first);
+
+            for (auto n=0; n<pad; n++) {
+                T mirror = *(last - 2 - n);
+                ext[n] = (padtype == PadType::odd) ? 2*(*(last - 1)) - mirror : mirror;
+            }
+
+            if (pad > 0) (*this)(ext.begin(), ext.end(), ext_y.begin());
+
+            // step 3: backward pass, from the reversed right extension
+            std::reverse(ext_y.begin(), ext_y.end());
+            set_state(steady_state(pad > 0 ? ext_y[0] : *(d_first + len - 1)));
+            if (pad > 0) (*this)(ext_y.begin(), ext_y.end(), ext_y.begin());
+
+            OutputIt end = d_first + len;
+
+            while (end - d_first >= M*M) {
+
+                end -= M*M;
+
+                for (auto n=0; n<M; n++) x[n].load(&*(end + n*M));
+
+                _permuteV_reverse_inplace(x);
+                _S.series_option3_inplace(x);
+                _permuteV_reverse_inplace(x);
+
+                for (auto n=0; n<M; n++) x[n].store(&*(end + n*M));
+            }
+
+            // the first samples that cannot fill a matrix, reversed in one matrix on stack
+            const int rem = end - d_first;
+
+            if (rem > 0) {
+                T buf[M*M];
+
+                for (auto n=0; n<rem; n++) buf[n] = *(d_first + rem - 1 - n);
+                _remainder_option3(buf, buf + rem, buf);
+                for (auto n=0; n<rem; n++) *(d_first + rem - 1 - n) = buf[n];
+            }
+
+            set_state(state);
+
+            return d_first + len;
+        };
+
+        /* 
+            higher order filter of cascaded option 3 on multiple threads, a block-level parallel prefix across threads:
+            1. the trunk is split into chunks (multiple of M*K), each chunk is filtered on its own thread from zero 
+               pre-conditions (the first chunk from the current pre-conditions), and its final state is kept.
+            2. the true pre-conditions of each chunk are forwarded sequentially: S_{j+1} = F_j + A^L*S_j, where F_j
+               is the final state of zero pre-conditions and A^L is the state transition over one chunk.
+            3. the homogeneous part from S_j, i.e., the response to zero input, is added to each chunk on its thread.
+         */
+        template<typename InputIt, typename OutputIt> inline OutputIt cascaded_parallel(InputIt first, InputIt last, OutputIt d_first, 
+                                                                                        int n_threads=std::thread::hardware_concurrency()) {
+
+            // state of all sections
+            using state_t = FilterState<T,N>;
+            const state_t zero;
+
+            const long len = last - first;
+
+            // length of the chunks but the last one, which takes the rest.
+            const long L = n_threads > 1 ? (len/n_threads)/(M*K)*(M*K) : 0;
+
+            if (L == 0) return (*this)(first, last, d_first);
+
+            std::vector<Filter> workers(n_threads, *this);
+            
+            // states[j]: pre-conditions of the j-th chunk, i.e., the final state of the (j-1)-th chunk
+            std::vector<state_t> states(n_threads + 1);
+            std::vector<std::thread> pool;
+
+            // step 1: filter chunks from zero pre-conditions.
+            for (auto j=0; j<n_threads; j++) {
+                pool.emplace_back([&, j]() {
+                    InputIt end = (j == n_threads - 1) ? last : first + (j+1)*L;
+
+                    if (j > 0) workers[j].set_inits(zero.s);
+                    workers[j](first + j*L, end, d_first + j*L);
+                    workers[j].get_inits(states[j+1].s);
+                });
+            }
+            for (auto& p: pool) p.join();
+            pool.clear();
+
+            // step 2: forward the true pre-conditions chunk by chunk, the last chunk by the power of its own length.
+            StateTransition<N> A(_coeffs);
+            A.power(L);
+
+            for (auto j=1; j<n_threads-1; j++) A.forward(states[j].s, states[j+1].s);
+
+            A.power(len - (n_threads-1)*L);
+            A.forward(states[n_threads-1].s, states[n_threads].s);
+
+            // step 3: add the homogeneous part of each chunk.
+            for (auto j=1; j<n_threads; j++) {
+                pool.emplace_back([&, j]() {
+                    OutputIt end = (j == n_threads - 1) ? d_first + len : d_first + (j+1)*L;
+
+                    workers[j].set_inits(states[j].s);
+                    workers[j]._add_homogeneous(d_first + j*L, end);
+                });
+            }
+            for (auto& p: pool) p.join();
+
+            // continue from the end of the trunk in the next call
+            set_inits(states[n_threads].s);
+
+            return d_first + len;
+        };
+
 };
 
 #endif // header guard 
@@ -0,0 +1,103 @@
+#ifndef FUSED_SERIES_H
+#define FUSED_SERIES_H 1
+
+#include <array>
+#include <bit>
+#include "vectorclass.h"
+#include "zero_init_condition.h"
+#include "init_cond_correction.h"
+
+/*
+    cascaded N second order sections fused into one kernel of option 3 (the transposes at head and tail cancelled between
+    sections). Unlike Series, which walks N separate cores each holding its own zic, icc and shift registers, the coefficients
+    of all sections are packed into one contiguous block aligned to the cache line, and the pre-conditions into another,
+    so one tile is passed through every section by the static kernels of zic and icc while it stays in registers.
+ */
+template<typename V, int N> class FusedSeries{
+
+    // V: data type of SIMD vector. T: data type of values in SIMD vector
+    using T = decltype(std::declval<V>().extract(0));
+
+    // M: length of SIMD vector.
+    constexpr static int M = V::size();
+
+    // R: levels of recursive doubling, i.e., the initialization and log_2(M) recursions.
+    constexpr static int R = std::bit_width(unsigned(M));
+
+    // coefficients of one section used by the kernels, the vectors first to keep them aligned.
+    struct Coeffs {
+        // vectors including C for recursive doubling, [22, 12, 21, 11] of each level.
+        V rd[R][4];
+
+        // vectors in matrix A, A=[h2 h1].
+        V h2, h1;
+
+        // coefficients of recursive equation: y_n = b_0x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
+        T b0, b1, b2, a1, a2;
+    };
+
+    private:
+
+        // coefficient block of all sections
+        alignas(64) Coeffs _c[N];
+
+        // pre-conditions of all sections, i.e., x_{-1}, x_{-2}, y_{-1}, y_{-2}.
+        T _s[N][4];
+
+    public:
+
+        // default constructor
+        FusedSeries(){};
+
+        // Parameterized constructor, pack the sections given by the array of coefficients (in T or double) and pre-conditions as series_from_coeffs.
+        template<typename U> FusedSeries(const U (&coeffs)[N][5], const U (&inits)[N][4]={0}) {
+
+            for (auto i=0; i<N; i++) {
+                _c[i].b0 = coeffs[i][0];
+                _c[i].b1 = coeffs[i][1];
+                _c[i].b2 = coeffs[i][2];
+                _c[i].a1 = coeffs[i][3];
+                _c[i].a2 = coeffs[i][4];
+
+                // the vectors are pre-computed by the icc of the section once
+                InitCondCorc<V>(coeffs[i][3], coeffs[i][4]).get_coeffs_T(_c[i].rd, R, _c[i].h2, _c[i].h1);
+            }
+
+            set_inits(inits);
+        };
+
+        // read the pre-conditions of all sections, inits[i] = [x_{-1}, x_{-2}, y_{-1}, y_{-2}] of the i-th section
+        inline void get_inits(T (*inits)[4]) {
+            for (auto i=0; i<N; i++) for (auto k=0; k<4; k++) inits[i][k] = _s[i][k];
+        };
+
+        // overwrite the pre-conditions of all sections
+        template<typename U> inline void set_inits(const U (*inits)[4]) {
+            for (auto i=0; i<N; i++) for (auto k=0; k<4; k++) _s[i][k] = inits[i][k];
+        };
+
+        // pass one caller-owned matrix (len valid samples, zero padded) through all sections of option 3 in place
+        inline void series_option3_inplace(std::array<V,M>& x, const int len=M*M) {
+
+            for (auto i=0; i<N; i++) {
+                const Coeffs& c = _c[i];
+                T* s = _s[i];
+
+                if (c.b0 == 1) ZeroInitCond<V>::template ZIC_T_kernel<false, true>(x, c.b0, c.b1, c.b2, c.a1, c.a2, s[0], s[1], len);
+                else ZeroInitCond<V>::ZIC_T_kernel(x, c.b0, c.b1, c.b2, c.a1, c.a2, s[0], s[1], len);
+                InitCondCorc<V>::ICC_T_kernel(x, c.rd, c.h2, c.h1, s[2], s[3], len);
+            }
+        };
+
+        // pass one matrix of samples through all sections of option 3
+        inline std::array<V,M> series_option3(const std::array<V,M>& x, const int len=M*M) {
+            std::array<V,M> y = x;
+
+            series_option3_inplace(y, len);
+
+            return y;
+        };
+
+};
+
+#endif // header guard
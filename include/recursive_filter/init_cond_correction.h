@@ -2,11 +2,36 @@
 #define INIT_COND_CORRECTION_H 1
 
 #include <array>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include "vectorclass.h"
+#include "simd_vector.h"
 #include "shift_reg.h"
-
-// initial condition correction that calculates the homogeneous part of recursive equation.
-template<typename V> class InitCondCorc{
+#include "lane_patterns.h"
+
+// algorithms of the homogeneous part in multi-block filtering: ICC_T (recursive doubling), ICC_T_MM (matrix multiplication) 
+// and ICC2_T (recursive doubling in a different tree), selected at compile time, e.g., by the planner.
+enum class IccAlgorithm { rd, mm, rd2 };
+
+/* 
+    tables of the homogeneous part pre-computed by InitCondCorc, selected at compile time. A and the vectors for recursive
+    doubling are always kept (ICC_NT, ICC_T, and ICC_T for partial matrices of the others), the rest by the policy:
+        rd: nothing more, ICC_T_MM and ICC2_T do not compile.
+        rd2: the four vectors of C for ICC2_T.
+        mm: C and the four M by M matrices of T for ICC_T_MM and ICC2_T.
+        lazy: the tables of mm, built on the heap once, on the first call of ICC_T_MM or ICC2_T by any of the copies of the
+              filter, and shared by all the copies (default). The first calls from several threads wait for one build.
+ */
+enum class IccTables { rd, rd2, mm, lazy };
+
+/* 
+    initial condition correction that calculates the homogeneous part of recursive equation.
+    K: rows of the tile in multi-block filtering, i.e., each of the M lanes holds a block of K samples (K = M, 2M, 4M ...).
+    C and the vectors of recursive doubling are taken over the block of K samples, and ICC_T forwards K-2 rows.
+ */
+template<typename V, IccTables P = IccTables::lazy, int K = V::size()> class InitCondCorc{
 
     // V: data type of SIMD vector. T: data type of values in SIMD vector 
     using T = decltype(std::declval<V>().extract(0));
@@ -14,31 +39,63 @@ template<typename V> class InitCondCorc{
     // M: length of SIMD vector.
     constexpr static int M = V::size();
 
-    private:
+    // R: levels of recursive doubling, i.e., the initialization and log_2(M) recursions.
+    constexpr static int R = std::bit_width(unsigned(M));
 
-        // coefficients of recursive equation: y_n = x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
-        T _a1, _a2; 
-        
-        // vectors contain the elements at the four positions of C, C^2, C^3 ...
-        V _h_22, _h_12, _h_21, _h_11;
+    static_assert(K >= M && K % M == 0, "the rows of the tile K must be a multiple of M");
+    static_assert(K == M || P == IccTables::rd || P == IccTables::lazy, "ICC_T_MM and ICC2_T take M by M matrices only");
+
+    // the rows of A forwarding the first K-2 rows of Y^T: the vectors of A itself for K = M, K scalars otherwise.
+    using fwd_t = std::conditional_t<K == M, V, std::array<T,K>>;
+
+    // vectors contain the elements at the four positions of C, C^2, C^3 ... (ICC2_T)
+    struct _Powers {
+        V h_22, h_12, h_21, h_11;
+    };
+
+    // C and the first vectors of large matrix T (ICC_T_MM)
+    struct _Tables: _Powers {
+        std::array<V,M> T_22, T_12, T_21, T_11;
+    };
 
-        // pre-compute the vectors including C for recursive doubling initialization
-        V _rd0_22, _rd0_12, _rd0_21, _rd0_11; 
+    // tables of the lazy policy: the coefficients in double to build them, and the tables once built. The holder is made
+    // by the constructor, thus the copies share it, and the tables in it, whenever they are built.
+    struct _LazyHolder {
+        double a1, a2;
+        std::once_flag once;
+        std::unique_ptr<const _Tables> tables;
+    };
 
-        // pre-compute the vectors including C for RD first recursion
-        V _rd1_22, _rd1_12, _rd1_21, _rd1_11; 
+    struct _Lazy {
+        std::shared_ptr<_LazyHolder> holder;
+    };
 
-        // pre-compute the vectors including C for RD second recursion
-        V _rd2_22, _rd2_12, _rd2_21, _rd2_11;
+    struct _None {};
 
-        // pre-compute the vectors including C for RD third recursion
-        V _rd3_22, _rd3_12, _rd3_21, _rd3_11;
+    // A over the block of K samples, for K != M
+    struct _Forward {
+        std::array<T,K> h2, h1;
+    };
+
+    struct _NoForward {};
+
+    using _tables_t = std::conditional_t<P == IccTables::rd, _None, 
+                      std::conditional_t<P == IccTables::rd2, _Powers, 
+                      std::conditional_t<P == IccTables::mm, _Tables, _Lazy>>>;
+
+    private:
+
+        // coefficients of recursive equation: y_n = x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
+        T _a1, _a2; 
 
-        // pre-compute the vectors including C for RD fourth recursion
-        V _rd4_22, _rd4_12, _rd4_21, _rd4_11;
+        // the rounding errors of a_1 and a_2 in T, zero unless the coefficients are given in double to a core of float, see ICC_S.
+        T _a1_lo, _a2_lo;
 
-        // the first vectors for large matrix T for old large matrix multiplication (MM) method
-        std::array<V,M> _T_22, _T_12, _T_21, _T_11;
+        /* 
+            pre-compute the vectors including C for recursive doubling: _rd[0] for the initialization, _rd[k] for the k-th recursion,
+            each in the four positions of C, i.e., [22, 12, 21, 11]. log_2(M) recursions are used.
+         */
+        V _rd[R][4];
 
         // shift register inside icc storeing the pre-condition of homogeneous part, i.e., y_{-1}, y_{-2}.
         Shift<V> _S;
@@ -46,44 +103,114 @@ template<typename V> class InitCondCorc{
         // vectors in matrix A, A=[h2 h1].
         V _h2, _h1;
 
+        // the tables of ICC_T_MM and ICC2_T kept by the policy, no storage for rd.
+        [[no_unique_address]] _tables_t _t;
+
+        // A over the block of K samples, no storage for K = M.
+        [[no_unique_address]] std::conditional_t<K == M, _NoForward, _Forward> _f;
+
+        // the tables of ICC_T_MM, built here by the lazy policy
+        inline const _Tables& _tables() {
+            static_assert(P == IccTables::mm || P == IccTables::lazy, "ICC_T_MM needs the tables of IccTables::mm or IccTables::lazy");
+
+            if constexpr (P == IccTables::lazy) {
+                _LazyHolder& h = *_t.holder;
+
+                std::call_once(h.once, [&h]() {
+                    auto t = std::make_unique<_Tables>();
+                    T_MM(h.a1, h.a2, *t);
+                    h.tables = std::move(t);
+                });
+
+                return *h.tables;
+            } else {
+                return _t;
+            }
+        };
+
+        // the vectors of C for ICC2_T
+        inline const _Powers& _powers() {
+            static_assert(P != IccTables::rd, "ICC2_T needs the tables of IccTables::rd2, IccTables::mm or IccTables::lazy");
+
+            if constexpr (P == IccTables::rd2) return _t;
+            else return _tables();
+        };
+
     public:
 
         // default constructor
         InitCondCorc(){};
 
-        // Parameterized constructor, initialize the homogeneous part of recursive equation, including the coefficients and pre-conditions
-        InitCondCorc(const T a1, const T a2, const T yi1=0, const T yi2=0): _a1(a1), _a2(a2) { 
+        /* 
+            Parameterized constructor, initialize the homogeneous part of recursive equation, including the coefficients and pre-conditions.
+            the coefficients are taken in double, and A, the powers of C and T are pre-computed in double and rounded to T once, 
+            since the powers of C drift in float for poles near the unit circle.
+         */
+        InitCondCorc(const double a1, const double a2, const T yi1=0, const T yi2=0): _a1(a1), _a2(a2), 
+                                                                                       _a1_lo(a1 - double(T(a1))), _a2_lo(a2 - double(T(a2))) { 
 
             // initialize the pre-conditions of the homogeneous part: y_{-2}, y_{-1}.
             _S.shift(yi2);
             _S.shift(yi1);
 
-            // pre-compute matrix A.
-            impulse_response();
+            // pre-compute matrix A, and A over the block of K samples for the tile of K rows.
+            impulse_response(a1, a2);
+            if constexpr (K != M) forward_coeffs(a1, a2);
 
             // pre-compute the vectors including C in recursive doubling.
-            recursive_doubling_vectors();
-
-            // pre-compute matrix T(and D) in matrix multplication (MM) method
-            T_MM();
+            recursive_doubling_vectors(a1, a2);
+
+            // pre-compute C of ICC2_T, or C and matrix T(and D) in matrix multplication (MM) method, as the policy
+            if constexpr (P == IccTables::rd2) C_power(a1, a2, _t);
+            if constexpr (P == IccTables::mm) T_MM(a1, a2, _t);
+            if constexpr (P == IccTables::lazy) {
+                _t.holder = std::make_shared<_LazyHolder>();
+                _t.holder->a1 = a1;
+                _t.holder->a2 = a2;
+            }
         };
 
         
+        // copy the coefficients used by ICC_T, i.e., the vectors for recursive doubling and matrix A.
+        inline void get_coeffs_T(V (*rd)[4], const int levels, V& h2, V& h1) {
+            for (auto k=0; k<levels; k++) for (auto i=0; i<4; i++) rd[k][i] = _rd[k][i];
+
+            h2 = _h2;
+            h1 = _h1;
+        };
+
+        // read the pre-conditions of the homogeneous part, i.e., y_{-1}, y_{-2}.
+        inline void get_inits(T& yi1, T& yi2) {
+            yi1 = _S[-1];
+            yi2 = _S[-2];
+        };
+
+        // overwrite the pre-conditions of the homogeneous part.
+        inline void set_inits(const T yi1, const T yi2) {
+            _S.shift(yi2);
+            _S.shift(yi1);
+        };
+
+
         /* 
         
             Functions for calculating homogeneous part of second order recursive equation, which are
             ICC_NT: block filtering
             ICC_T: multi-block filtering by recursive filtering (in the paper, recommand)
+            ICC_T_inplace: the same as ICC_T in place
             ICC_T_MM: multi-block filtering by matrix multiplication (in the paper, not recommand)
             ICC2_T: multi-block filtering by recursive filtering in a different tree (not in the paper, slower, not recommand)
+            ICC_T_inplace_by: one of the three in place, selected by IccAlgorithm
 
          */
 
 
-        // calculate the homogeneous part of recursive equation by scalar
+        // calculate the homogeneous part of recursive equation by scalar, by a_1 and a_2 in double as the sum of two values in T
         inline T ICC_S(const T w) {
             T y = w + _a1*_S[-1] + _a2*_S[-2];
 
+            y += _a1_lo*_S[-1] + _a2_lo*_S[-2];
+
             _S.shift(y);
 
             return y;
@@ -102,9 +229,54 @@ template<typename V> class InitCondCorc{
             return y;
         };
 
-        // calculate the homogeneous part of recursive equation by multi-block filtering and recursive doubling.
-        inline std::array<V,M> ICC_T(const std::array<V,M>& w) { 
-            std::array<V,M> y;
+        // calculate the homogeneous part of recursive equation by multi-block filtering and recursive doubling. len: number of valid samples in W^T.
+        inline std::array<V,K> ICC_T(const std::array<V,K>& w, const int len=M*K) { 
+            std::array<V,K> y = w;
+
+            ICC_T_inplace(y, len);
+
+            return y;
+        };
+
+        // multi-block filtering on the caller-owned matrix W^T, which is overwritten by Y^T. Each block of W^T is read before
+        // the same block of Y^T is written, thus w and y can share the storage. row0, step: see ICC_T_kernel.
+        inline void ICC_T_inplace(std::array<V,K>& y, const int len=M*K, const int row0=0, const int step=1) { 
+            T y1 = _S[-1], y2 = _S[-2];
+
+            if constexpr (K == M) ICC_T_kernel(y, _rd, _h2, _h1, y1, y2, len, row0, step);
+            else ICC_T_kernel(y, _rd, _f.h2, _f.h1, y1, y2, len, row0, step);
+
+            // 2 times scalar shift
+            _S.shift(y2);
+            _S.shift(y1);
+        };
+
+        // multi-block filtering in place by the algorithm A. ICC_T_MM and ICC2_T take whole matrices only, thus a partial matrix
+        // falls back to ICC_T, which carries the same pre-conditions.
+        template<IccAlgorithm A> inline void ICC_T_inplace_by(std::array<V,K>& y, const int len=M*K) { 
+            if constexpr (A == IccAlgorithm::mm) {
+                if (len == M*M) y = ICC_T_MM(y);
+                else ICC_T_inplace(y, len);
+            } else if constexpr (A == IccAlgorithm::rd2) {
+                if (len == M*M) y = ICC2_T(y);
+                else ICC_T_inplace(y, len);
+            } else {
+                ICC_T_inplace(y, len);
+            }
+        };
+
+        /* 
+            kernel of ICC_T on the coefficients and pre-conditions given by reference, shared by the cores and the fused cascade 
+            in fused_series.h. rd: vectors for recursive doubling, h2, h1: matrix A, y1, y2: y_{-1}, y_{-2}, updated for the next matrix.
+            row0, step: only the blocks row0, row0+step, ... of the first K-2 blocks are forwarded, the others are left as W^T,
+            e.g., the blocks holding no sample kept by the decimation. The last two blocks are always complete, which carry 
+            the pre-conditions, thus the blocks must all be forwarded (the default) for a partial matrix.
+            for K > M rows, the recursive doubling runs on the last two rows as for M, by C over the block of K samples,
+            and the first K-2 rows are forwarded by A over the block.
+         */
+        static inline void ICC_T_kernel(std::array<V,K>& y, const V (*rd)[4], const fwd_t& h2, const fwd_t& h1, T& y1, T& y2, const int len=M*K,
+                                        const int row0=0, const int step=1) { 
+            const std::array<V,K>& w = y;
 
             // the two blocks contains the initial conditions in homogeneous part, Y_p^T=[yi2 yi1].
             V yi2, yi1;
@@ -113,129 +285,52 @@ template<typename V> class InitCondCorc{
             V b2, b1;
 
             // recursive doubling step 1: initialization
-            y[M-2] = mul_add(_rd0_22, _S[-2], w[M-2]);
-            y[M-2] = mul_add(_rd0_12, _S[-1], y[M-2]);
-            y[M-1] = mul_add(_rd0_21, _S[-2], w[M-1]);
-            y[M-1] = mul_add(_rd0_11, _S[-1], y[M-1]);
+            y[K-2] = mul_add(rd[0][0], y2, w[K-2]);
+            y[K-2] = mul_add(rd[0][1], y1, y[K-2]);
+            y[K-1] = mul_add(rd[0][2], y2, w[K-1]);
+            y[K-1] = mul_add(rd[0][3], y1, y[K-1]);
             
-            // SSE
-            if constexpr (M == 4) {
-                // step 2: first recursion
-                b2 = permute4<-1,0,-1,2>(y[M-2]);
-                b1 = permute4<-1,0,-1,2>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _rd1_22, y[M-2]);
-                y[M-2] = mul_add(b1, _rd1_12, y[M-2]);
-                y[M-1] = mul_add(b2, _rd1_21, y[M-1]);
-                y[M-1] = mul_add(b1, _rd1_11, y[M-1]);
-
-                // step 3: second recursion
-                b2 = permute4<-1,-1,1,1>(y[M-2]);
-                b1 = permute4<-1,-1,1,1>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _rd2_22, y[M-2]);
-                y[M-2] = mul_add(b1, _rd2_12, y[M-2]);
-                y[M-1] = mul_add(b2, _rd2_21, y[M-1]);
-                y[M-1] = mul_add(b1, _rd2_11, y[M-1]);
-
-                // shuffle for getting Y_p^T from the last two blocks of Y^T, i.e., Y^T_{[M-2]}, Y^T_{[M-1]}.
-                yi2 = blend4<4,0,1,2>(y[M-2], _S[-2]);
-                yi1 = blend4<4,0,1,2>(y[M-1], _S[-1]);
-            };
-
-            // AVX2
-            if constexpr (M == 8) { 
-                // step 2: first recursion
-                b2 = permute8<-1,0,-1,2,-1,4,-1,6>(y[M-2]);
-                b1 = permute8<-1,0,-1,2,-1,4,-1,6>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _rd1_22, y[M-2]);
-                y[M-2] = mul_add(b1, _rd1_12, y[M-2]);
-                y[M-1] = mul_add(b2, _rd1_21, y[M-1]);
-                y[M-1] = mul_add(b1, _rd1_11, y[M-1]);
-
-                // step 3: second recursion
-                b2 = permute8<-1,-1,1,1,-1,-1,5,5>(y[M-2]);
-                b1 = permute8<-1,-1,1,1,-1,-1,5,5>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _rd2_22, y[M-2]);
-                y[M-2] = mul_add(b1, _rd2_12, y[M-2]);
-                y[M-1] = mul_add(b2, _rd2_21, y[M-1]);
-                y[M-1] = mul_add(b1, _rd2_11, y[M-1]);
-
-                // step 4: third recursion
-                b2 = permute8<-1,-1,-1,-1,3,3,3,3>(y[M-2]);
-                b1 = permute8<-1,-1,-1,-1,3,3,3,3>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _rd3_22, y[M-2]);
-                y[M-2] = mul_add(b1, _rd3_12, y[M-2]);
-                y[M-1] = mul_add(b2, _rd3_21, y[M-1]);
-                y[M-1] = mul_add(b1, _rd3_11, y[M-1]);
-
-                yi2 = blend8<8,0,1,2,3,4,5,6>(y[M-2], _S[-2]);
-                yi1 = blend8<8,0,1,2,3,4,5,6>(y[M-1], _S[-1]);
-            };
-
-            // AVX512
-            if constexpr (M == 16) { 
-                // step 2: first recursion
-                b2 = permute16<-1,0,-1,2,-1,4,-1,6,-1,8,-1,10,-1,12,-1,14>(y[M-2]);
-                b1 = permute16<-1,0,-1,2,-1,4,-1,6,-1,8,-1,10,-1,12,-1,14>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _rd1_22, y[M-2]);
-                y[M-2] = mul_add(b1, _rd1_12, y[M-2]);
-                y[M-1] = mul_add(b2, _rd1_21, y[M-1]);
-                y[M-1] = mul_add(b1, _rd1_11, y[M-1]);
-
-                // step 3: second recursion
-                b2 = permute16<-1,-1,1,1,-1,-1,5,5,-1,-1,9,9,-1,-1,13,13>(y[M-2]);
-                b1 = permute16<-1,-1,1,1,-1,-1,5,5,-1,-1,9,9,-1,-1,13,13>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _rd2_22, y[M-2]);
-                y[M-2] = mul_add(b1, _rd2_12, y[M-2]);
-                y[M-1] = mul_add(b2, _rd2_21, y[M-1]);
-                y[M-1] = mul_add(b1, _rd2_11, y[M-1]);
-
-                // step 4: third recursion
-                b2 = permute16<-1,-1,-1,-1,3,3,3,3,-1,-1,-1,-1,11,11,11,11>(y[M-2]);
-                b1 = permute16<-1,-1,-1,-1,3,3,3,3,-1,-1,-1,-1,11,11,11,11>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _rd3_22, y[M-2]);
-                y[M-2] = mul_add(b1, _rd3_12, y[M-2]);
-                y[M-1] = mul_add(b2, _rd3_21, y[M-1]);
-                y[M-1] = mul_add(b1, _rd3_11, y[M-1]);
-
-                // step 4: fourth recursion
-                b2 = permute16<-1,-1,-1,-1,-1,-1,-1,-1,7,7,7,7,7,7,7,7>(y[M-2]);
-                b1 = permute16<-1,-1,-1,-1,-1,-1,-1,-1,7,7,7,7,7,7,7,7>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _rd4_22, y[M-2]);
-                y[M-2] = mul_add(b1, _rd4_12, y[M-2]);
-                y[M-1] = mul_add(b2, _rd4_21, y[M-1]);
-                y[M-1] = mul_add(b1, _rd4_11, y[M-1]);
-
-                yi2 = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(y[M-2], _S[-2]);
-                yi1 = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(y[M-1], _S[-1]);
-            };
-
-            // forward the first M-2 blocks in Y^T
-            for (auto n=0; n<M-2; n++) {
-                y[n] = mul_add(yi2, _h2[n], w[n]);
-                y[n] = mul_add(yi1, _h1[n], y[n]);
-            };
+            // steps 2 to log_2(M)+1: recursions on the groups of 2h lanes, h=1,2,...,M/2
+            _static_for<R-1>([&](auto l) {
+                constexpr int h = 1 << decltype(l)::value;
+
+                b2 = _permute_as<_Spread<M,h>>(y[K-2]);
+                b1 = _permute_as<_Spread<M,h>>(y[K-1]);
+
+                y[K-2] = mul_add(b2, rd[l+1][0], y[K-2]);
+                y[K-2] = mul_add(b1, rd[l+1][1], y[K-2]);
+                y[K-1] = mul_add(b2, rd[l+1][2], y[K-1]);
+                y[K-1] = mul_add(b1, rd[l+1][3], y[K-1]);
+            });
+
+            // shuffle for getting Y_p^T from the last two blocks of Y^T, i.e., Y^T_{[K-2]}, Y^T_{[K-1]}.
+            yi2 = _shift_inV(y[K-2], y2);
+            yi1 = _shift_inV(y[K-1], y1);
+
+            // forward the first K-2 blocks in Y^T, none for the 2 by 2 matrix
+            if constexpr (K > 2) {
+                for (auto n=row0; n<K-2; n+=step) {
+                    y[n] = mul_add(yi2, h2[n], w[n]);
+                    y[n] = mul_add(yi1, h1[n], y[n]);
+                };
+            }
      
             /* 
-                2 times scalar shift:
                 store initial conditions for the next block of data, which are the last samples in the last two blocks of X^T.
+                for a partial matrix, the last two valid samples are stored instead (see ZIC_T), none for an empty one.
              */         
-            _S.shift(y[M-2][M-1]);
-            _S.shift(y[M-1][M-1]); 
-            
-            return y; 
+            if (len > 0) {
+                y2 = (len > 1) ? y[(len-2)%K][(len-2)/K] : y1;
+                y1 = y[(len-1)%K][(len-1)/K]; 
+            }
         };
 
         // calculate the homogeneous part of recursive equation by multi-block filtering in large matrix multiplication (MM). Not recommand.
         inline std::array<V,M> ICC_T_MM(const std::array<V,M>& w) { 
+            static_assert(K == M, "ICC_T_MM takes M by M matrices only");
+
+            const _Tables& t = _tables();
+
             std::array<V,M> y{0};
 
             // the two blocks contains the initial conditions in homogeneous part, Y_p^T=[yi2 yi1].
@@ -243,39 +338,24 @@ template<typename V> class InitCondCorc{
 
             // large matrix multiplication seperated by 4 sub-matrices multiplications.
             for (auto n=0; n<M; n++) {
-                y[M-2] = mul_add(_T_22[n], w[M-2][n], y[M-2]);
-                y[M-2] = mul_add(_T_12[n], w[M-1][n], y[M-2]);
+                y[M-2] = mul_add(t.T_22[n], w[M-2][n], y[M-2]);
+                y[M-2] = mul_add(t.T_12[n], w[M-1][n], y[M-2]);
             }
 
-            y[M-2] = mul_add(_h_22, _S[-2], y[M-2]);
-            y[M-2] = mul_add(_h_12, _S[-1], y[M-2]);
+            y[M-2] = mul_add(t.h_22, _S[-2], y[M-2]);
+            y[M-2] = mul_add(t.h_12, _S[-1], y[M-2]);
 
             for (auto n=0; n<M; n++) {
-                y[M-1] = mul_add(_T_21[n], w[M-2][n], y[M-1]);
-                y[M-1] = mul_add(_T_11[n], w[M-1][n], y[M-1]);
-            }
-
-            y[M-1] = mul_add(_h_21, _S[-2], y[M-1]);
-            y[M-1] = mul_add(_h_11, _S[-1], y[M-1]);
-
-            // SSE
-            if constexpr (M == 4) {
-                // shuffle for getting Y_p^T from the last two blocks of Y^T, i.e., Y^T_{[M-2]}, Y^T_{[M-1]}.
-                yi2 = blend4<4,0,1,2>(y[M-2], _S[-2]);
-                yi1 = blend4<4,0,1,2>(y[M-1], _S[-1]);
+                y[M-1] = mul_add(t.T_21[n], w[M-2][n], y[M-1]);
+                y[M-1] = mul_add(t.T_11[n], w[M-1][n], y[M-1]);
             }
 
-            // AVX2
-            if constexpr (M == 8) {
-                yi2 = blend8<8,0,1,2,3,4,5,6>(y[M-2], _S[-2]);
-                yi1 = blend8<8,0,1,2,3,4,5,6>(y[M-1], _S[-1]);
-            }
+            y[M-1] = mul_add(t.h_21, _S[-2], y[M-1]);
+            y[M-1] = mul_add(t.h_11, _S[-1], y[M-1]);
 
-            // AVX512
-            if constexpr (M == 16) {
-                yi2 = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(y[M-2], _S[-2]);
-                yi1 = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(y[M-1], _S[-1]);
-            }
+            // shuffle for getting Y_p^T from the last two blocks of Y^T, i.e., Y^T_{[M-2]}, Y^T_{[M-1]}.
+            yi2 = _shift_inV(y[M-2], _S[-2]);
+            yi1 = _shift_inV(y[M-1], _S[-1]);
 
             for (auto n=0; n<M-2; n++) {
                 y[n] = mul_add(yi2, _h2[n], w[n]);
@@ -298,6 +378,10 @@ template<typename V> class InitCondCorc{
             (slower thus not introduced in the paper)        
          */
         inline std::array<V,M> ICC2_T(const std::array<V,M>& w) { 
+            static_assert(K == M, "ICC2_T takes M by M matrices only");
+
+            const _Powers& t = _powers();
+
             std::array<V,M> y;
 
             V yi2, yi1, b2{0}, b1{0};
@@ -307,114 +391,28 @@ template<typename V> class InitCondCorc{
             b1.insert(0,_S[-1]);
             
             // recursive doubling step 1: initialization (same).
-            y[M-2] = mul_add(b2, _h_22[0], w[M-2]); 
-            y[M-2] = mul_add(b1, _h_12[0], y[M-2]);
-            y[M-1] = mul_add(b2, _h_21[0], w[M-1]);
-            y[M-1] = mul_add(b1, _h_11[0], y[M-1]);
-
-            // SSE
-            if constexpr (M == 4){
-                // step 2: first recursion
-                b2 = permute4<-1,0,1,2>(y[M-2]); // b2 = [0 y_{M-2} y_{2M-2} y_{3M-2}]^T
-                b1 = permute4<-1,0,1,2>(y[M-1]); 
-
-                // y[M-2] = C_{[0][0]}*[0 y_{M-2} y_{2M-2} y_{3M-2}]^T + C_{[0][1]}*[0 y_{M-1} y_{2M-1} y_{3M-1}]^T
-                y[M-2] = mul_add(b2, _h_22[0], y[M-2]); 
-                y[M-2] = mul_add(b1, _h_12[0], y[M-2]); 
-                // y[M-1] = C_{[1][0]}*[0 y_{M-2} y_{2M-2} y_{3M-2}]^T + C_{[1][1]}*[0 y_{M-1} y_{2M-1} y_{3M-1}]^T
-                y[M-1] = mul_add(b2, _h_21[0], y[M-1]);
-                y[M-1] = mul_add(b1, _h_11[0], y[M-1]);
-
-                // step 3: second recursion
-                b2 = permute4<-1,-1,0,1>(y[M-2]); // b2 = [0 0 y_{M-2} y_{2M-2}]^T
-                b1 = permute4<-1,-1,0,1>(y[M-1]);
-
-                // y[M-2] = C^2_{[0][0]}*[0 0 y_{M-2} y_{2M-2}]^T + C^2_{[0][1]}*[0 0 y_{M-1} y_{2M-1}]^T
-                y[M-2] = mul_add(b2, _h_22[1], y[M-2]);
-                y[M-2] = mul_add(b1, _h_12[1], y[M-2]);
-                // y[M-1] = C^2_{[1][0]}*[0 0 y_{M-2} y_{2M-2}]^T + C^2_{[1][1]}*[0 0 y_{M-1} y_{2M-1}]^T
-                y[M-1] = mul_add(b2, _h_21[1], y[M-1]);
-                y[M-1] = mul_add(b1, _h_11[1], y[M-1]);
-
-                // shuffle for getting Y_p^T from the last two blocks of Y^T, i.e., Y^T_{[M-2]}, Y^T_{[M-1]}.
-                yi2 = blend4<4,0,1,2>(y[M-2], _S[-2]);
-                yi1 = blend4<4,0,1,2>(y[M-1], _S[-1]);
-            };
+            y[M-2] = mul_add(b2, t.h_22[0], w[M-2]); 
+            y[M-2] = mul_add(b1, t.h_12[0], y[M-2]);
+            y[M-1] = mul_add(b2, t.h_21[0], w[M-1]);
+            y[M-1] = mul_add(b1, t.h_11[0], y[M-1]);
 
-            // AVX2
-            if constexpr (M == 8){
-                // step 2: first recursion
-                b2 = permute8<-1,0,1,2,3,4,5,6>(y[M-2]);
-                b1 = permute8<-1,0,1,2,3,4,5,6>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _h_22[0], y[M-2]);
-                y[M-2] = mul_add(b1, _h_12[0], y[M-2]);
-                y[M-1] = mul_add(b2, _h_21[0], y[M-1]);
-                y[M-1] = mul_add(b1, _h_11[0], y[M-1]);
-
-                // step 3: second recursion
-                b2 = permute8<-1,-1,0,1,2,3,4,5>(y[M-2]);
-                b1 = permute8<-1,-1,0,1,2,3,4,5>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _h_22[1], y[M-2]);
-                y[M-2] = mul_add(b1, _h_12[1], y[M-2]);
-                y[M-1] = mul_add(b2, _h_21[1], y[M-1]);
-                y[M-1] = mul_add(b1, _h_11[1], y[M-1]);
-
-                // step 4: third recursion
-                b2 = permute8<-1,-1,-1,-1,0,1,2,3>(y[M-2]);
-                b1 = permute8<-1,-1,-1,-1,0,1,2,3>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _h_22[3], y[M-2]);
-                y[M-2] = mul_add(b1, _h_12[3], y[M-2]);
-                y[M-1] = mul_add(b2, _h_21[3], y[M-1]);
-                y[M-1] = mul_add(b1, _h_11[3], y[M-1]);
-
-                yi2 = blend8<8,0,1,2,3,4,5,6>(y[M-2], _S[-2]);
-                yi1 = blend8<8,0,1,2,3,4,5,6>(y[M-1], _S[-1]);
-            };
+            // steps 2 to log_2(M)+1: recursions by C^d, d=1,2,...,M/2, e.g., b2 = [0 y_{M-2} y_{2M-2} y_{3M-2}]^T for d=1
+            _static_for<R-1>([&](auto l) {
+                constexpr int d = 1 << decltype(l)::value;
 
-            // AVX512
-            if constexpr (M == 16){
-                // step 2: first recursion
-                b2 = permute16<-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(y[M-2]);
-                b1 = permute16<-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _h_22[0], y[M-2]);
-                y[M-2] = mul_add(b1, _h_12[0], y[M-2]);
-                y[M-1] = mul_add(b2, _h_21[0], y[M-1]);
-                y[M-1] = mul_add(b1, _h_11[0], y[M-1]);
-
-                // step 3: second recursion
-                b2 = permute16<-1,-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13>(y[M-2]);
-                b1 = permute16<-1,-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _h_22[1], y[M-2]);
-                y[M-2] = mul_add(b1, _h_12[1], y[M-2]);
-                y[M-1] = mul_add(b2, _h_21[1], y[M-1]);
-                y[M-1] = mul_add(b1, _h_11[1], y[M-1]);
-
-                // step 4: third recursion
-                b2 = permute16<-1,-1,-1,-1,0,1,2,3,4,5,6,7,8,9,10,11>(y[M-2]);
-                b1 = permute16<-1,-1,-1,-1,0,1,2,3,4,5,6,7,8,9,10,11>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _h_22[3], y[M-2]);
-                y[M-2] = mul_add(b1, _h_12[3], y[M-2]);
-                y[M-1] = mul_add(b2, _h_21[3], y[M-1]);
-                y[M-1] = mul_add(b1, _h_11[3], y[M-1]);
-
-                // step 5: fourth recursion
-                b2 = permute16<-1,-1,-1,-1,-1,-1,-1,-1,0,1,2,3,4,5,6,7>(y[M-2]);
-                b1 = permute16<-1,-1,-1,-1,-1,-1,-1,-1,0,1,2,3,4,5,6,7>(y[M-1]);
-
-                y[M-2] = mul_add(b2, _h_22[7], y[M-2]);
-                y[M-2] = mul_add(b1, _h_12[7], y[M-2]);
-                y[M-1] = mul_add(b2, _h_21[7], y[M-1]);
-                y[M-1] = mul_add(b1, _h_11[7], y[M-1]);
-
-                yi2 = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(y[M-2], _S[-2]);
-                yi1 = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(y[M-1], _S[-1]);
-            };
+                b2 = _shiftV<d>(y[M-2]);
+                b1 = _shiftV<d>(y[M-1]);
+
+                // y[M-2] = C^d_{[0][0]}*b2 + C^d_{[0][1]}*b1, y[M-1] = C^d_{[1][0]}*b2 + C^d_{[1][1]}*b1
+                y[M-2] = mul_add(b2, t.h_22[d-1], y[M-2]);
+                y[M-2] = mul_add(b1, t.h_12[d-1], y[M-2]);
+                y[M-1] = mul_add(b2, t.h_21[d-1], y[M-1]);
+                y[M-1] = mul_add(b1, t.h_11[d-1], y[M-1]);
+            });
+
+            // shuffle for getting Y_p^T from the last two blocks of Y^T, i.e., Y^T_{[M-2]}, Y^T_{[M-1]}.
+            yi2 = _shift_inV(y[M-2], _S[-2]);
+            yi1 = _shift_inV(y[M-1], _S[-1]);
 
             for (auto n=0; n<M-2; n++){
                 y[n] = mul_add(yi2, _h2[n], w[n]);
@@ -440,133 +438,91 @@ template<typename V> class InitCondCorc{
 
 
         // calculate matrix A for icc, which is further used for pre-computing vectors for recursive doubling and large MM method   
-        inline void impulse_response() {
+        inline void impulse_response(const double a1, const double a2) {
 
-            T h0[M+1];
-            
+            double h0[M+1], h2[M];
+
+            A(a1, a2, h0, h2);
+
+            _h2 = load_rounded<V>(&h2[0]);
+            _h1 = load_rounded<V>(&h0[1]);
+        };
+
+        // matrix A in double over a block of L samples, h0: impulse response of the homogeneous part, i.e., h1 = h0[1:L+1], and h2 = a_2*h0[0:L].
+        static inline void A(const double a1, const double a2, double* h0, double* h2, const int L=M) {
             h0[0] = 1;
-            h0[1] = _a1;
+            h0[1] = a1;
 
-            for (auto n=2; n<M+1; n++) {
-                h0[n] = _a1*h0[n-1] + _a2*h0[n-2];
+            for (auto n=2; n<L+1; n++) {
+                h0[n] = a1*h0[n-1] + a2*h0[n-2];
             }    
 
-            _h2.load(&h0[0]);
-            _h2 *= _a2;
-            _h1.load(&h0[1]);
+            for (auto n=0; n<L; n++) h2[n] = a2*h0[n];
         };
 
-        // calculate vectors contain the elements at the four positions of C, C^2, C^3 ...
-        inline void C_power() { 
+        // calculate matrix A over the block of K samples, which forwards the first K-2 rows of Y^T in ICC_T for K != M.
+        inline void forward_coeffs(const double a1, const double a2) {
+
+            double h0[K+1], h2[K];
+
+            A(a1, a2, h0, h2, K);
+
+            for (auto n=0; n<K; n++) {
+                _f.h2[n] = h2[n];
+                _f.h1[n] = h0[n+1];
+            }
+        };
+
+        // calculate vectors contain the elements at the four positions of C, C^2, C^3 ..., C over the block of K samples.
+        static inline void C_power(const double a1, const double a2, _Powers& c) { 
         
-            T h_22[M] = {0}, h_12[M] = {0}, h_21[M] = {0}, h_11[M] = {0}; 
+            double h0[K+1], h2[K], h1[K];
+            double h_22[M] = {0}, h_12[M] = {0}, h_21[M] = {0}, h_11[M] = {0}; 
+
+            A(a1, a2, h0, h2, K);
+            for (auto n=0; n<K; n++) h1[n] = h0[n+1];
 
-            h_22[0] = _h2[M-2];
-            h_12[0] = _h1[M-2];
-            h_21[0] = _h2[M-1];
-            h_11[0] = _h1[M-1];
+            h_22[0] = h2[K-2];
+            h_12[0] = h1[K-2];
+            h_21[0] = h2[K-1];
+            h_11[0] = h1[K-1];
 
             for (auto n=1; n<M; n++) {
-                h_22[n] = _h2[M-2]*h_22[n-1] + _h2[M-1]*h_12[n-1];
-                h_12[n] = _h1[M-2]*h_22[n-1] + _h1[M-1]*h_12[n-1];
-                h_21[n] = _h2[M-2]*h_21[n-1] + _h2[M-1]*h_11[n-1];
-                h_11[n] = _h1[M-2]*h_21[n-1] + _h1[M-1]*h_11[n-1];
+                h_22[n] = h2[K-2]*h_22[n-1] + h2[K-1]*h_12[n-1];
+                h_12[n] = h1[K-2]*h_22[n-1] + h1[K-1]*h_12[n-1];
+                h_21[n] = h2[K-2]*h_21[n-1] + h2[K-1]*h_11[n-1];
+                h_11[n] = h1[K-2]*h_21[n-1] + h1[K-1]*h_11[n-1];
             }
 
-            _h_22.load(&h_22[0]);
-            _h_12.load(&h_12[0]);
-            _h_21.load(&h_21[0]);
-            _h_11.load(&h_11[0]);
+            c.h_22 = load_rounded<V>(&h_22[0]);
+            c.h_12 = load_rounded<V>(&h_12[0]);
+            c.h_21 = load_rounded<V>(&h_21[0]);
+            c.h_11 = load_rounded<V>(&h_11[0]);
         };
 
         // calculate the vectors including elements of C in recursive doubling
-        inline void recursive_doubling_vectors() {
-
-            C_power();
-
-            // log_2(M) number of recursion, SSE
-            if constexpr (M == 4) {
-
-                // RD initialization, [C 0 0 0]
-                _rd0_22 = permute4<0,-1,-1,-1>(_h_22); 
-                _rd0_12 = permute4<0,-1,-1,-1>(_h_12);
-                _rd0_21 = permute4<0,-1,-1,-1>(_h_21);
-                _rd0_11 = permute4<0,-1,-1,-1>(_h_11);
-
-                // RD recursion 1, [0 C 0 C]
-                _rd1_22 = permute4<-1,0,-1,0>(_h_22);
-                _rd1_12 = permute4<-1,0,-1,0>(_h_12);
-                _rd1_21 = permute4<-1,0,-1,0>(_h_21);
-                _rd1_11 = permute4<-1,0,-1,0>(_h_11);
-
-                // RD recursion 2, [0 0 C C^2]
-                _rd2_22 = permute4<-1,-1,0,1>(_h_22);
-                _rd2_12 = permute4<-1,-1,0,1>(_h_12);
-                _rd2_21 = permute4<-1,-1,0,1>(_h_21);
-                _rd2_11 = permute4<-1,-1,0,1>(_h_11);
-            };
+        inline void recursive_doubling_vectors(const double a1, const double a2) {
 
-            // AVX2
-            if constexpr (M == 8) {
-
-                // RD initialization, [C 0 0 0 0 0 0 0]
-                _rd0_22 = permute8<0,-1,-1,-1,-1,-1,-1,-1>(_h_22); 
-                _rd0_12 = permute8<0,-1,-1,-1,-1,-1,-1,-1>(_h_12);
-                _rd0_21 = permute8<0,-1,-1,-1,-1,-1,-1,-1>(_h_21);
-                _rd0_11 = permute8<0,-1,-1,-1,-1,-1,-1,-1>(_h_11);
-
-                // RD recursion 1, [0 C 0 C 0 C 0 C]
-                _rd1_22 = permute8<-1,0,-1,0,-1,0,-1,0>(_h_22);
-                _rd1_12 = permute8<-1,0,-1,0,-1,0,-1,0>(_h_12);
-                _rd1_21 = permute8<-1,0,-1,0,-1,0,-1,0>(_h_21);
-                _rd1_11 = permute8<-1,0,-1,0,-1,0,-1,0>(_h_11);
-
-                // RD recursion 2, [0 0 C C^2 0 0 C C^2]
-                _rd2_22 = permute8<-1,-1,0,1,-1,-1,0,1>(_h_22);
-                _rd2_12 = permute8<-1,-1,0,1,-1,-1,0,1>(_h_12);
-                _rd2_21 = permute8<-1,-1,0,1,-1,-1,0,1>(_h_21);
-                _rd2_11 = permute8<-1,-1,0,1,-1,-1,0,1>(_h_11);
-
-                // RD recursion 3, [0 0 0 0 C C^2 C^3 C^4]
-                _rd3_22 = permute8<-1,-1,-1,-1,0,1,2,3>(_h_22);
-                _rd3_12 = permute8<-1,-1,-1,-1,0,1,2,3>(_h_12);
-                _rd3_21 = permute8<-1,-1,-1,-1,0,1,2,3>(_h_21);
-                _rd3_11 = permute8<-1,-1,-1,-1,0,1,2,3>(_h_11);
-            };
+            // C is only needed for deriving the vectors, thus not kept
+            _Powers c;
 
-            // AVX512
-            if constexpr (M == 16) {
-
-                // RD initialization, [C 0 0 ... 0]
-                _rd0_22 = permute16<0,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1>(_h_22); 
-                _rd0_12 = permute16<0,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1>(_h_12);
-                _rd0_21 = permute16<0,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1>(_h_21);
-                _rd0_11 = permute16<0,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1>(_h_11);
-
-                // RD recursion 1, [0 C 0 C ... 0 C]
-                _rd1_22 = permute16<-1,0,-1,0,-1,0,-1,0,-1,0,-1,0,-1,0,-1,0>(_h_22);
-                _rd1_12 = permute16<-1,0,-1,0,-1,0,-1,0,-1,0,-1,0,-1,0,-1,0>(_h_12);
-                _rd1_21 = permute16<-1,0,-1,0,-1,0,-1,0,-1,0,-1,0,-1,0,-1,0>(_h_21);
-                _rd1_11 = permute16<-1,0,-1,0,-1,0,-1,0,-1,0,-1,0,-1,0,-1,0>(_h_11);
-
-                // RD recursion 2, [0 0 C C^2 0 0 C C^2 ... 0 0 C C^2]
-                _rd2_22 = permute16<-1,-1,0,1,-1,-1,0,1,-1,-1,0,1,-1,-1,0,1>(_h_22);
-                _rd2_12 = permute16<-1,-1,0,1,-1,-1,0,1,-1,-1,0,1,-1,-1,0,1>(_h_12);
-                _rd2_21 = permute16<-1,-1,0,1,-1,-1,0,1,-1,-1,0,1,-1,-1,0,1>(_h_21);
-                _rd2_11 = permute16<-1,-1,0,1,-1,-1,0,1,-1,-1,0,1,-1,-1,0,1>(_h_11);
-
-                // RD recursion 3, [0 0 0 0 C C^2 C^3 C^4 0 0 0 0 C C^2 C^3 C^4]
-                _rd3_22 = permute16<-1,-1,-1,-1,0,1,2,3,-1,-1,-1,-1,0,1,2,3>(_h_22);
-                _rd3_12 = permute16<-1,-1,-1,-1,0,1,2,3,-1,-1,-1,-1,0,1,2,3>(_h_12);
-                _rd3_21 = permute16<-1,-1,-1,-1,0,1,2,3,-1,-1,-1,-1,0,1,2,3>(_h_21);
-                _rd3_11 = permute16<-1,-1,-1,-1,0,1,2,3,-1,-1,-1,-1,0,1,2,3>(_h_11);
-
-                // RD recursion 4, [0 0 0 0 0 0 0 0 C C^2 C^3 C^4 C^5 C^6 C^7 C^8]
-                _rd4_22 = permute16<-1,-1,-1,-1,-1,-1,-1,-1,0,1,2,3,4,5,6,7>(_h_22);
-                _rd4_12 = permute16<-1,-1,-1,-1,-1,-1,-1,-1,0,1,2,3,4,5,6,7>(_h_12);
-                _rd4_21 = permute16<-1,-1,-1,-1,-1,-1,-1,-1,0,1,2,3,4,5,6,7>(_h_21);
-                _rd4_11 = permute16<-1,-1,-1,-1,-1,-1,-1,-1,0,1,2,3,4,5,6,7>(_h_11);
-            };
+            C_power(a1, a2, c);
+
+            // RD initialization, [C 0 0 ... 0]
+            _rd[0][0] = _permute_as<_First<M>>(c.h_22); 
+            _rd[0][1] = _permute_as<_First<M>>(c.h_12);
+            _rd[0][2] = _permute_as<_First<M>>(c.h_21);
+            _rd[0][3] = _permute_as<_First<M>>(c.h_11);
+
+            // log_2(M) number of recursion on the groups of 2h lanes, e.g., [0 C 0 C ...], [0 0 C C^2 0 0 C C^2 ...], ...
+            _static_for<R-1>([&](auto l) {
+                constexpr int h = 1 << decltype(l)::value;
+
+                _rd[l+1][0] = _permute_as<_Repeat<M,h>>(c.h_22);
+                _rd[l+1][1] = _permute_as<_Repeat<M,h>>(c.h_12);
+                _rd[l+1][2] = _permute_as<_Repeat<M,h>>(c.h_21);
+                _rd[l+1][3] = _permute_as<_Repeat<M,h>>(c.h_11);
+            });
         };
 
         /* 
@@ -575,59 +531,21 @@ template<typename V> class InitCondCorc{
             Basically, T is a 2M by 2M matrix, where each sub-matrix of size M by M 
             is lower triangular toplitz matrix related to 4 vectors in C power and D is exactly C power. 
          */
-        inline void T_MM() {
-
-            C_power();
-
-            // SSE
-            if constexpr (M == 4) {
-
-                _T_22[0] = blend4<4,0,1,2>(_h_22,1);
-                _T_12[0] = permute4<-1,0,1,2>(_h_12);
-                _T_21[0] = permute4<-1,0,1,2>(_h_21);
-                _T_11[0] = blend4<4,0,1,2>(_h_11,1);
-
-                for (auto n=1; n<M; n++){
-
-                    _T_22[n] = permute4<-1,0,1,2>(_T_22[n-1]);
-                    _T_12[n] = permute4<-1,0,1,2>(_T_12[n-1]);
-                    _T_21[n] = permute4<-1,0,1,2>(_T_21[n-1]);
-                    _T_11[n] = permute4<-1,0,1,2>(_T_11[n-1]);
-                }
-            }
-
-            // AVX2
-            if constexpr (M == 8){
-
-                _T_22[0] = blend8<8,0,1,2,3,4,5,6>(_h_22,1);
-                _T_12[0] = permute8<-1,0,1,2,3,4,5,6>(_h_12);
-                _T_21[0] = permute8<-1,0,1,2,3,4,5,6>(_h_21);
-                _T_11[0] = blend8<8,0,1,2,3,4,5,6>(_h_11,1);
-
-                for (auto n=1; n<M; n++){
-
-                    _T_22[n] = permute8<-1,0,1,2,3,4,5,6>(_T_22[n-1]);
-                    _T_12[n] = permute8<-1,0,1,2,3,4,5,6>(_T_12[n-1]);
-                    _T_21[n] = permute8<-1,0,1,2,3,4,5,6>(_T_21[n-1]);
-                    _T_11[n] = permute8<-1,0,1,2,3,4,5,6>(_T_11[n-1]);
-                }
-            }
+        static inline void T_MM(const double a1, const double a2, _Tables& t) {
 
-            // AVX512
-            if constexpr (M == 16){
+            C_power(a1, a2, t);
 
-                _T_22[0] = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(_h_22,1);
-                _T_12[0] = permute16<-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(_h_12);
-                _T_21[0] = permute16<-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(_h_21);
-                _T_11[0] = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(_h_11,1);
+            t.T_22[0] = _shift_inV(t.h_22, 1);
+            t.T_12[0] = _shiftV<1>(t.h_12);
+            t.T_21[0] = _shiftV<1>(t.h_21);
+            t.T_11[0] = _shift_inV(t.h_11, 1);
 
-                for (auto n=1; n<M; n++){
+            for (auto n=1; n<M; n++){
 
-                    _T_22[n] = permute16<-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(_T_22[n-1]);
-                    _T_12[n] = permute16<-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(_T_12[n-1]);
-                    _T_21[n] = permute16<-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(_T_21[n-1]);
-                    _T_11[n] = permute16<-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(_T_11[n-1]);
-                }
+                t.T_22[n] = _shiftV<1>(t.T_22[n-1]);
+                t.T_12[n] = _shiftV<1>(t.T_12[n-1]);
+                t.T_21[n] = _shiftV<1>(t.T_21[n-1]);
+                t.T_11[n] = _shiftV<1>(t.T_11[n-1]);
             }
         };
 
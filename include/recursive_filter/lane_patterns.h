@@ -0,0 +1,109 @@
+#ifndef LANE_PATTERNS_H
+#define LANE_PATTERNS_H 1
+
+#include <utility>
+#include <type_traits>
+#include "vectorclass.h"
+
+/*
+    the shuffles of the kernels as lane patterns generated at compile time for any power-of-two M, instead of the indices
+    written out for each vector length. A pattern P gives P::at(n), the source lane of the n-th lane of the result (-1: zero),
+    counted in the vector for a permute and in the concatenation [a b] for a blend. The patterns are expanded into
+    permute2/4/8/16 and blend2/4/8/16 of vectorclass here, and into the native registers of WideVec in wide_vector.h.
+ */
+
+// shift the lanes up by d with zeros shifted in, [0 ... 0 v_0 v_1 ... v_{M-1-d}]
+template<int M, int d> struct _ShiftUp {
+    static constexpr int at(const int n) { return n < d ? -1 : n - d; }
+};
+
+// shift the lanes up by 1 with the first lane of b shifted in, [b_0 v_0 v_1 ... v_{M-2}]
+template<int M> struct _ShiftIn {
+    static constexpr int at(const int n) { return n == 0 ? M : n - 1; }
+};
+
+// shift the lanes down by 1 with the first lane of b shifted in at the end, [v_1 v_2 ... v_{M-1} b_0]
+template<int M> struct _ShiftOut {
+    static constexpr int at(const int n) { return n + 1; }
+};
+
+// recursive doubling on the groups of 2h lanes: the upper h lanes of each group take the last of the lower h, the lower are zeros.
+template<int M, int h> struct _Spread {
+    static constexpr int at(const int n) { return n%(2*h) < h ? -1 : n - n%(2*h) + h - 1; }
+};
+
+// the first h lanes repeated in the upper h lanes of each group of 2h lanes, the lower are zeros, e.g., [0 0 C C^2 0 0 C C^2].
+template<int M, int h> struct _Repeat {
+    static constexpr int at(const int n) { return n%(2*h) < h ? -1 : n%(2*h) - h; }
+};
+
+// the first lane only, [v_0 0 ... 0]
+template<int M> struct _First {
+    static constexpr int at(const int n) { return n == 0 ? 0 : -1; }
+};
+
+// the lanes in the reverse order
+template<int M> struct _Reverse {
+    static constexpr int at(const int n) { return M - 1 - n; }
+};
+
+// expand the pattern P into the permute of vectorclass for the length of V
+template<typename P, typename V, int... n> inline V _permute_by(const V& a, std::integer_sequence<int, n...>) {
+    // SSE of double
+    if constexpr (V::size() == 2) return permute2<P::at(n)...>(a);
+    // SSE
+    if constexpr (V::size() == 4) return permute4<P::at(n)...>(a);
+    // AVX2
+    if constexpr (V::size() == 8) return permute8<P::at(n)...>(a);
+    // AVX512
+    if constexpr (V::size() == 16) return permute16<P::at(n)...>(a);
+};
+
+// expand the pattern P into the blend of vectorclass for the length of V
+template<typename P, typename V, int... n> inline V _blend_by(const V& a, const V& b, std::integer_sequence<int, n...>) {
+    // SSE of double
+    if constexpr (V::size() == 2) return blend2<P::at(n)...>(a, b);
+    // SSE
+    if constexpr (V::size() == 4) return blend4<P::at(n)...>(a, b);
+    // AVX2
+    if constexpr (V::size() == 8) return blend8<P::at(n)...>(a, b);
+    // AVX512
+    if constexpr (V::size() == 16) return blend16<P::at(n)...>(a, b);
+};
+
+// permute the lanes of a by the pattern P
+template<typename P, typename V> inline V _permute_as(const V& a) {
+    return _permute_by<P>(a, std::make_integer_sequence<int, V::size()>{});
+};
+
+// blend the lanes of a and b by the pattern P
+template<typename P, typename V> inline V _blend_as(const V& a, const V& b) {
+    return _blend_by<P>(a, b, std::make_integer_sequence<int, V::size()>{});
+};
+
+// shift the lanes up by d, zeros shifted in
+template<int d, typename V> inline V _shiftV(const V& v) {
+    return _permute_as<_ShiftUp<V::size(),d>>(v);
+};
+
+// shift the lanes up by 1 with the scalar s in the first lane, e.g., [x_{-1} x_0 ... x_{M-2}] from x and x_{-1}
+template<typename V> inline V _shift_inV(const V& v, const decltype(std::declval<V>().extract(0)) s) {
+    return _blend_as<_ShiftIn<V::size()>>(v, V(s));
+};
+
+// shift the lanes down by 1 with the scalar s in the last lane
+template<typename V> inline V _shift_outV(const V& v, const decltype(std::declval<V>().extract(0)) s) {
+    return _blend_as<_ShiftOut<V::size()>>(v, V(s));
+};
+
+// reverse the order of elements in a vector
+template<typename V> inline V _reverseV(const V& v) {
+    return _permute_as<_Reverse<V::size()>>(v);
+};
+
+// call f(std::integral_constant<int,k>{}) for k = 0, 1, ..., R-1, i.e., a loop over the levels of the shuffles unrolled at compile time.
+template<int R, typename F> inline void _static_for(F&& f) {
+    [&]<int... k>(std::integer_sequence<int, k...>) { (f(std::integral_constant<int, k>{}), ...); }(std::make_integer_sequence<int, R>{});
+};
+
+#endif // header guard
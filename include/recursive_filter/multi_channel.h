@@ -0,0 +1,156 @@
+#ifndef MULTI_CHANNEL_H
+#define MULTI_CHANNEL_H 1
+
+#include <array>
+#include <algorithm>
+#include "simd_vector.h"
+#include "permuteV.h"
+
+/*
+    filter C independent channels sharing the same cascaded second order sections, where channel c is mapped to lane c%M of
+    the (c/M)-th vector. Each lane runs the plain scalar recurrence, so neither the matrix transpose nor the recursive doubling
+    is required, and the K=ceil(C/M) vectors form K independent chains of FMA per sample.
+ */
+template<typename T, int N, int C, typename V = simd_vector_t<T>> class MultiChannelFilter{
+
+    // M: length of SIMD vector.
+    constexpr static int M = V::size();
+
+    // K: number of vectors holding one frame of C channels.
+    constexpr static int K = (C + M - 1)/M;
+
+    private:
+
+        // coefficients of recursive equation of each section: y_n = b_0x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
+        std::array<T,N> _b0, _b1, _b2, _a1, _a2;
+
+        // pre-conditions of each section and each vector of channels, i.e., x_{-1}, x_{-2}, y_{-1}, y_{-2}.
+        std::array<std::array<V,K>,N> _x1, _x2, _y1, _y2;
+
+        // pass the k-th vector of channels at one time instant into the cascaded sections by the scalar recurrence in each lane.
+        inline V _proc(V x, const int k) {
+            V y;
+
+            for (auto s=0; s<N; s++) {
+                y = mul_add(_x2[s][k], _b2[s], x*_b0[s]);
+                y = mul_add(_x1[s][k], _b1[s], y);
+                y = mul_add(_y2[s][k], _a2[s], y);
+                y = mul_add(_y1[s][k], _a1[s], y);
+
+                // shift the pre-conditions
+                _x2[s][k] = _x1[s][k];
+                _x1[s][k] = x;
+                _y2[s][k] = _y1[s][k];
+                _y1[s][k] = y;
+
+                x = y;
+            }
+
+            return y;
+        };
+
+    public:
+
+        // default constructor
+        MultiChannelFilter(){};
+
+        // Parameterized constructor, initialize the sections by array of coefficients and pre-conditions shared by all channels.
+        MultiChannelFilter(const T (&coeffs)[N][5], const T (&inits)[N][4]) {
+
+            for (auto s=0; s<N; s++) {
+                _b0[s] = coeffs[s][0];
+                _b1[s] = coeffs[s][1];
+                _b2[s] = coeffs[s][2];
+                _a1[s] = coeffs[s][3];
+                _a2[s] = coeffs[s][4];
+
+                for (auto k=0; k<K; k++) {
+                    _x1[s][k] = V(inits[s][0]);
+                    _x2[s][k] = V(inits[s][1]);
+                    _y1[s][k] = V(inits[s][2]);
+                    _y2[s][k] = V(inits[s][3]);
+                }
+            }
+        };
+
+
+        /*
+
+            Multi-channel filtering that accepts a trunk of data in either layout:
+            interleaved: frames of C samples, i.e., x[n*C + c] is the n-th sample of channel c.
+            planar: C consecutive channels of equal length L=(last-first)/C, i.e., x[c*L + n] is the n-th sample of channel c.
+                    the channels are gathered into lanes by M by M matrix transpose.
+
+         */
+
+
+        // filter interleaved channels frame by frame, the incomplete frame at the end is not processed.
+        template<typename InputIt, typename OutputIt> inline OutputIt interleaved(InputIt first, InputIt last, OutputIt d_first) {
+            std::array<V,K> x, y;
+
+            while (first <= last - C) {
+
+                for (auto k=0; k<K; k++) {
+                    if (k*M + M <= C) x[k].load(&*(first + k*M));
+                    else x[k].load_partial(C - k*M, &*(first + k*M));
+                }
+
+                // the K vectors are independent chains
+                for (auto k=0; k<K; k++) y[k] = _proc(x[k], k);
+
+                for (auto k=0; k<K; k++) {
+                    if (k*M + M <= C) y[k].store(&*(d_first + k*M));
+                    else y[k].store_partial(C - k*M, &*(d_first + k*M));
+                }
+
+                // iterator += size of one frame
+                first += C;
+                d_first += C;
+            }
+
+            return d_first;
+        };
+
+        // filter planar channels by gathering M channels into lanes by matrix transpose.
+        template<typename InputIt, typename OutputIt> inline OutputIt planar(InputIt first, InputIt last, OutputIt d_first) {
+            std::array<V,M> x, y, x_T, y_T;
+
+            // length of each channel
+            const int L = (last - first)/C;
+
+            for (auto k=0; k<K; k++) {
+
+                // number of valid channels in the k-th group
+                const int m = std::min(C - k*M, M);
+
+                for (auto l=0; l<L; l+=M) {
+
+                    // number of valid samples of each channel in this matrix
+                    const int r = std::min(L - l, M);
+
+                    // row c: M samples of channel k*M+c
+                    for (auto c=0; c<M; c++) {
+                        if (c >= m) x[c] = V(0);
+                        else if (r == M) x[c].load(&*(first + (k*M+c)*L + l));
+                        else x[c].load_partial(r, &*(first + (k*M+c)*L + l));
+                    }
+
+                    // row n: the n-th sample of M channels
+                    x_T = _permuteV(x);
+                    for (auto n=0; n<r; n++) y_T[n] = _proc(x_T[n], k);
+                    for (auto n=r; n<M; n++) y_T[n] = V(0);
+                    y = _permuteV(y_T);
+
+                    for (auto c=0; c<m; c++) {
+                        if (r == M) y[c].store(&*(d_first + (k*M+c)*L + l));
+                        else y[c].store_partial(r, &*(d_first + (k*M+c)*L + l));
+                    }
+                }
+            }
+
+            return d_first + C*L;
+        };
+
+};
+
+#endif // header guard
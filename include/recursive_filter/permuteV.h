@@ -1,20 +1,21 @@
 #ifndef PERMUTEV_H
 #define PERMUTEV_H 1
 
+#include <algorithm>
 #include <array>
 #include "vectorclass.h"
+#include "lane_patterns.h"
 
-// matrix transpose for different size of matrices
-template<typename V> inline std::array<V,V::size()> _permuteV(const std::array<V,V::size()>& matrix) {
-    std::array<V,V::size()> matrix_T;
-    // SSE
-    if constexpr (V::size() == 4) _permuteV4(matrix.data(), matrix_T.data());
-    // AVX2
-    if constexpr (V::size() == 8) _permuteV8(matrix.data(), matrix_T.data());
-    // AVX512
-    if constexpr (V::size() == 16) _permuteV16(matrix.data(), matrix_T.data());
+// matrix transpose for matrix in size 2 by 2
+template<typename V> inline void _permuteV2(const V matrix[2], V matrix_T[2]) {
+    V tmp[2];
 
-    return matrix_T;
+    // swap the anti-diagonal elements
+    tmp[0] = blend2<0,2>(matrix[0], matrix[1]);
+    tmp[1] = blend2<1,3>(matrix[0], matrix[1]);
+
+    matrix_T[0] = tmp[0];
+    matrix_T[1] = tmp[1];
 };
 
 // matrix transpose for matrix in size 4 by 4
@@ -146,4 +147,157 @@ template<typename V> inline void _permuteV16(const V matrix[16], V matrix_T[16])
     matrix_T[15] = blend16<1,17,3,19,5,21,7,23,9,25,11,27,13,29,15,31>(tmp3[14], tmp3[15]); 
 };
 
+// matrix transpose for different size of matrices (defined after the kernels, which are not found by ADL when V is in VCL_NAMESPACE)
+template<typename V> inline std::array<V,V::size()> _permuteV(const std::array<V,V::size()>& matrix) {
+    std::array<V,V::size()> matrix_T;
+    // SSE of double
+    if constexpr (V::size() == 2) _permuteV2(matrix.data(), matrix_T.data());
+    // SSE
+    if constexpr (V::size() == 4) _permuteV4(matrix.data(), matrix_T.data());
+    // AVX2
+    if constexpr (V::size() == 8) _permuteV8(matrix.data(), matrix_T.data());
+    // AVX512
+    if constexpr (V::size() == 16) _permuteV16(matrix.data(), matrix_T.data());
+
+    return matrix_T;
+};
+
+// matrix transpose in place. The kernels read the whole matrix before writing the transpose, thus the two can alias.
+template<typename V> inline void _permuteV_inplace(std::array<V,V::size()>& matrix) {
+    // SSE of double
+    if constexpr (V::size() == 2) _permuteV2(matrix.data(), matrix.data());
+    // SSE
+    if constexpr (V::size() == 4) _permuteV4(matrix.data(), matrix.data());
+    // AVX2
+    if constexpr (V::size() == 8) _permuteV8(matrix.data(), matrix.data());
+    // AVX512
+    if constexpr (V::size() == 16) _permuteV16(matrix.data(), matrix.data());
+};
+
+/* 
+    matrix transpose in place of the time-reversed matrix: the samples s=0..M*M-1 of the matrix in rows are taken in 
+    the order M*M-1..0, i.e., the matrix is rotated by 180 degree, which commutes with the transpose. The rotation is 
+    a reversed order of the vectors (free in registers) and a reversal of the elements of each vector. 
+    Applied twice, the matrix is restored.
+ */
+template<typename V> inline void _permuteV_reverse_inplace(std::array<V,V::size()>& matrix) {
+    constexpr int M = V::size();
+    V tmp;
+
+    _permuteV_inplace(matrix);
+
+    for (auto n=0; n<M/2; n++) {
+        tmp = _reverseV(matrix[n]);
+        matrix[n] = _reverseV(matrix[M-1-n]);
+        matrix[M-1-n] = tmp;
+    }
+};
+
+/* 
+    convert a trunk of data between the natural order and the tile order of Filter::transposed, matrix by matrix:
+    the sample s of the k-th matrix, at first[k*M*M + s] in the natural order, is at first[k*M*M + (s%M)*M + s/M] in the
+    tile order, i.e., each matrix of M*M samples is stored as X^T, the row r holding the samples r, r+M, r+2M, ...
+    The transpose is its own inverse, thus the same function converts both ways. The last samples that cannot fill 
+    a matrix are copied in the natural order. 
+ */
+template<typename V, typename InputIt, typename OutputIt> inline OutputIt transpose_tiles(InputIt first, InputIt last, OutputIt d_first) {
+    constexpr int M = V::size();
+    std::array<V,M> x;
+
+    while (first <= last - M*M) {
+
+        for (auto n=0; n<M; n++) x[n].load(&*(first + n*M));
+
+        _permuteV_inplace(x);
+
+        for (auto n=0; n<M; n++) x[n].store(&*(d_first + n*M));
+
+        first += M*M;
+        d_first += M*M;
+    }
+
+    while (first < last) *d_first++ = *first++;
+
+    return d_first;
+};
+
+/* 
+    load M blocks of K samples (len valid samples, zero padded) into the register tile x as X^T by K/M transposes of M by M,
+    i.e., sample s at x[s%K][s/K]. Shared by the operator of Filter and DynamicFilter.
+ */
+template<typename V, size_t K, typename InputIt> inline void _load_tile(std::array<V,K>& x, InputIt first, const int len=V::size()*K) {
+    constexpr int M = V::size();
+    std::array<V,M> t;
+
+    if constexpr (K == M) {
+        if (len == M*M) {
+            for (auto n=0; n<M; n++) x[n].load(&*(first + n*M));
+            _permuteV_inplace(x);
+            return;
+        }
+    }
+
+    for (size_t c=0; c<K/M; c++) {
+        for (auto j=0; j<M; j++) {
+            // number of valid samples in the c-th vector of the j-th block
+            const int k = std::min(std::max(len - j*int(K) - int(c)*M, 0), M);
+
+            if (k == M) t[j].load(&*(first + j*K + c*M));
+            else if (k > 0) t[j].load_partial(k, &*(first + j*K + c*M));
+            else t[j] = V(0);
+        }
+
+        _permuteV_inplace(t);
+
+        for (auto n=0; n<M; n++) x[c*M + n] = t[n];
+    }
+};
+
+// store the first len samples of the register tile X^T, the inverse of _load_tile.
+template<typename V, size_t K, typename OutputIt> inline void _store_tile(const std::array<V,K>& x, OutputIt d_first, const int len=V::size()*K) {
+    constexpr int M = V::size();
+    std::array<V,M> t;
+
+    if constexpr (K == M) {
+        if (len == M*M) {
+            t = _permuteV(x);
+            for (auto n=0; n<M; n++) t[n].store(&*(d_first + n*M));
+            return;
+        }
+    }
+
+    for (size_t c=0; c<K/M; c++) {
+        for (auto n=0; n<M; n++) t[n] = x[c*M + n];
+
+        _permuteV_inplace(t);
+
+        for (auto j=0; j<M; j++) {
+            const int k = std::min(std::max(len - j*int(K) - int(c)*M, 0), M);
+
+            if (k == M) t[j].store(&*(d_first + j*K + c*M));
+            else if (k > 0) t[j].store_partial(k, &*(d_first + j*K + c*M));
+        }
+    }
+};
+
+/* 
+    filter the remainder (less than M*K samples) of a trunk in a zero padded register tile of K rows, by series(x, len) that
+    passes the tile X^T in place through the sections of option 3, e.g., Series::series_option3_inplace.
+ */
+template<typename V, size_t K, typename InputIt, typename OutputIt, typename F> 
+inline OutputIt _remainder_tile(InputIt first, InputIt last, OutputIt d_first, F&& series) {
+    std::array<V,K> x;
+
+    // number of valid samples in the tile
+    const int len = last - first;
+
+    if (len <= 0) return d_first;
+
+    _load_tile(x, first, len);
+    series(x, len);
+    _store_tile(x, d_first, len);
+
+    return d_first + len;
+};
+
 #endif
@@ -0,0 +1,390 @@
+#ifndef PLANNER_H
+#define PLANNER_H 1
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "simd_vector.h"
+#include "filter.h"
+#include "dispatch.h"
+
+/*
+
+    FFTW-style planner of Filter. Which path is the fastest depends on the width of SIMD vector M, the data type T,
+    the number of sections N and the length of the trunks, thus the candidates are timed on the machine instead:
+        width: M of Vec4f/Vec8f/Vec16f for float, Vec2d/Vec4d/Vec8d for double (the wider ones emulated by VCL if the
+               instruction set of the translation unit is narrower).
+        strategy: cascaded_scalar, cascaded_option1 (by ZIC_NT or ZIC_NT_RD), cascaded_option2, cascaded_option3, or the 
+                  register tile (cascaded_tile) by each algorithm of icc: ICC_T, ICC_T_MM and ICC2_T.
+        rows: K of the register tile, M, 2M and 4M for ICC_T (ICC_T_MM and ICC2_T take M by M matrices only), M otherwise.
+    The winner of each problem, i.e., (T, instruction set of the CPU, N, typical length rounded up to a power of 2), is kept in
+    the wisdom, which is saved to and loaded from a text file, thus only the first run of a machine pays the timing:
+
+        Wisdom wisdom("recursive_filter.wisdom");
+        PlannedFilter<float,6> F(coeffs, inits, 4096, wisdom);
+        F(x, x + len, y);
+
+ */
+
+
+// cascade strategies of Filter, see Filter. option1_rd: cascaded_option1 by ZicAlgorithm::rd, wavefront: cascaded_wavefront.
+enum class Strategy { scalar, option1, option2, option3, tile, option1_rd, wavefront };
+
+// a path of Filter: width of SIMD vector, strategy, algorithm of icc (tile only), rows of the tile K, and the time measured 
+// per sample.
+struct Plan {
+    int width;
+    Strategy strategy;
+    IccAlgorithm icc;
+    int rows;
+    double ns_per_sample;
+};
+
+// names of the strategies and algorithms of icc in the wisdom file
+inline const char* strategy_name(const Strategy s) {
+    const char* names[] = {"scalar", "option1", "option2", "option3", "tile", "option1_rd", "wavefront"};
+    return names[int(s)];
+};
+
+inline const char* icc_name(const IccAlgorithm a) {
+    const char* names[] = {"icc_t", "icc_t_mm", "icc2_t"};
+    return names[int(a)];
+};
+
+// the tables of icc used by a kernel, the others are not built, see IccTables
+constexpr IccTables tables_of(const Strategy s, const IccAlgorithm a) {
+    if (s != Strategy::tile || a == IccAlgorithm::rd) return IccTables::rd;
+    return (a == IccAlgorithm::mm) ? IccTables::mm : IccTables::rd2;
+};
+
+// the measured plans, one line per problem in the file: <key> <width> <strategy> <icc> <rows> <ns_per_sample>
+class Wisdom{
+
+    private:
+
+        // the file the new plans are saved to, none if empty
+        std::string _path;
+
+        std::map<std::string, Plan> _plans;
+
+    public:
+
+        // default constructor, kept in memory only
+        Wisdom(){};
+
+        // load the wisdom file if it exists, and save the new plans to the same file
+        Wisdom(const std::string& path): _path(path) {
+            load(path);
+        };
+
+        // merge the plans of a wisdom file, returns false if the file cannot be read
+        inline bool load(const std::string& path) {
+            std::ifstream is(path);
+            std::string line;
+
+            if (!is) return false;
+
+            while (std::getline(is, line)) {
+                std::istringstream fields(line);
+                std::string key, strategy, icc, extra;
+                Plan p;
+                bool known_strategy = false, known_icc = false;
+
+                // skip the lines of missing or extra fields, e.g., written by another version
+                if (!(fields >> key >> p.width >> strategy >> icc >> p.rows >> p.ns_per_sample) || (fields >> extra)) continue;
+
+                for (auto s=0; s<7; s++) if (strategy == strategy_name(Strategy(s))) { p.strategy = Strategy(s); known_strategy = true; }
+                for (auto a=0; a<3; a++) if (icc == icc_name(IccAlgorithm(a))) { p.icc = IccAlgorithm(a); known_icc = true; }
+
+                // skip the lines of unknown strategies or algorithms of icc, or of rows that are not a multiple of the width
+                if (known_strategy && known_icc && p.width > 0 && p.rows > 0 && p.rows % p.width == 0) _plans[key] = p;
+            }
+
+            return true;
+        };
+
+        // write all plans, returns false if the file cannot be written
+        inline bool save(const std::string& path) const {
+            std::ofstream os(path);
+
+            if (!os) return false;
+
+            for (auto& [key, p]: _plans) {
+                os << key << " " << p.width << " " << strategy_name(p.strategy) << " " << icc_name(p.icc) << " " << p.rows << " " << p.ns_per_sample << "\n";
+            }
+
+            return bool(os);
+        };
+
+        // write all plans to the file of the constructor
+        inline bool save() const {
+            return !_path.empty() && save(_path);
+        };
+
+        // the plan of a problem, nullptr if it has not been measured
+        inline const Plan* find(const std::string& key) const {
+            auto it = _plans.find(key);
+            return (it == _plans.end()) ? nullptr : &it->second;
+        };
+
+        inline void insert(const std::string& key, const Plan& p) {
+            _plans[key] = p;
+        };
+
+        inline size_t size() const {
+            return _plans.size();
+        };
+};
+
+// kernel of Filter bound to one strategy, algorithm of icc and rows of the tile, the same interface as the kernels of runtime 
+// dispatch. only the tables of icc of the algorithm are kept.
+template<typename T, int N, typename V, Strategy S, IccAlgorithm A, int K = V::size()> class PlannedKernel: public FilterKernel<T>{
+
+    private:
+
+        Filter<T,N,V,tables_of(S,A),K> _F;
+
+        std::string _name;
+
+    public:
+
+        PlannedKernel(const T (&coeffs)[N][5], const T (&inits)[N][4]): _F(coeffs, inits) {
+            _name = std::string("M:") + std::to_string(V::size()) + "/" + strategy_name(S);
+            if (S == Strategy::tile) _name += std::string("/") + icc_name(A);
+            if (K != V::size()) _name += std::string("/K:") + std::to_string(K);
+        };
+
+        T* operator()(const T* first, const T* last, T* d_first) override {
+            if constexpr (S == Strategy::scalar) return _F.cascaded_scalar(first, last, d_first);
+            else if constexpr (S == Strategy::option1) return _F.cascaded_option1(first, last, d_first);
+            else if constexpr (S == Strategy::option1_rd) return _F.template cascaded_option1<ZicAlgorithm::rd>(first, last, d_first);
+            else if constexpr (S == Strategy::option2) return _F.cascaded_option2(first, last, d_first);
+            else if constexpr (S == Strategy::option3) return _F.cascaded_option3(first, last, d_first);
+            else if constexpr (S == Strategy::wavefront) return _F.cascaded_wavefront(first, last, d_first);
+            else return _F.template cascaded_tile<A>(first, last, d_first);
+        };
+
+        void get_inits(T (*inits)[4]) override {
+            _F.get_inits(*reinterpret_cast<T (*)[N][4]>(inits));
+        };
+
+        void set_inits(const T (*inits)[4]) override {
+            _F.set_inits(*reinterpret_cast<const T (*)[N][4]>(inits));
+        };
+
+        // the path bound, e.g., M:8/tile/icc_t or M:8/tile/icc_t/K:16
+        const char* isa() const override {
+            return _name.c_str();
+        };
+};
+
+// candidates of Filter<T,N>, timing and the lookup of the wisdom
+template<typename T, int N> class Planner{
+
+    using kernel_t = std::unique_ptr<FilterKernel<T>>;
+    using factory_t = kernel_t (*)(const T (&)[N][5], const T (&)[N][4]);
+
+    struct Candidate {
+        Plan plan;
+        factory_t make;
+    };
+
+    private:
+
+        template<typename V, Strategy S, IccAlgorithm A, int K = V::size()> 
+        static kernel_t _make(const T (&coeffs)[N][5], const T (&inits)[N][4]) {
+            return std::make_unique<PlannedKernel<T,N,V,S,A,K>>(coeffs, inits);
+        };
+
+        // the strategies of one width, the scalar path is the same for all widths thus added for the narrowest only
+        template<typename V> static void _add(std::vector<Candidate>& c, const bool scalar) {
+            constexpr int M = V::size();
+            constexpr IccAlgorithm rd = IccAlgorithm::rd, mm = IccAlgorithm::mm, rd2 = IccAlgorithm::rd2;
+
+            if (scalar) c.push_back({{M, Strategy::scalar, rd, M, 0}, &_make<V, Strategy::scalar, rd>});
+            c.push_back({{M, Strategy::option1, rd, M, 0}, &_make<V, Strategy::option1, rd>});
+            c.push_back({{M, Strategy::option1_rd, rd, M, 0}, &_make<V, Strategy::option1_rd, rd>});
+            c.push_back({{M, Strategy::option2, rd, M, 0}, &_make<V, Strategy::option2, rd>});
+            c.push_back({{M, Strategy::option3, rd, M, 0}, &_make<V, Strategy::option3, rd>});
+            c.push_back({{M, Strategy::tile, rd, M, 0}, &_make<V, Strategy::tile, rd>});
+            c.push_back({{M, Strategy::tile, rd, 2*M, 0}, &_make<V, Strategy::tile, rd, 2*M>});
+            c.push_back({{M, Strategy::tile, rd, 4*M, 0}, &_make<V, Strategy::tile, rd, 4*M>});
+            c.push_back({{M, Strategy::tile, mm, M, 0}, &_make<V, Strategy::tile, mm>});
+            c.push_back({{M, Strategy::tile, rd2, M, 0}, &_make<V, Strategy::tile, rd2>});
+
+            // cascaded_wavefront is not a candidate until wavefront_bench shows a gain over the operator on hardware
+        };
+
+        static const std::vector<Candidate>& _candidates() {
+            static const std::vector<Candidate> c = []() {
+                std::vector<Candidate> c;
+
+                if constexpr (std::is_same_v<T, float>) {
+                    _add<Vec4f>(c, true);
+                    _add<Vec8f>(c, false);
+                    _add<Vec16f>(c, false);
+                } else {
+                    _add<Vec2d>(c, true);
+                    _add<Vec4d>(c, false);
+                    _add<Vec8d>(c, false);
+                }
+
+                return c;
+            }();
+
+            return c;
+        };
+
+        // best time of runs on len samples per sample in ns, about 10 ms per kernel after one warm up run.
+        static double _time(FilterKernel<T>& K, const std::vector<T>& x, std::vector<T>& y) {
+            const long len = x.size();
+            double best = INFINITY, total = 0;
+
+            K(x.data(), x.data() + len, y.data());
+
+            for (auto r=0; r<100 && (r < 3 || total < 1e7); r++) {
+                auto start = std::chrono::steady_clock::now();
+
+                K(x.data(), x.data() + len, y.data());
+
+                double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+                best = std::min(best, ns);
+                total += ns;
+            }
+
+            return best/len;
+        };
+
+    public:
+
+        // all candidates of Filter<T,N>
+        static std::vector<Plan> candidates() {
+            std::vector<Plan> p;
+
+            for (auto& c: _candidates()) p.push_back(c.plan);
+
+            return p;
+        };
+
+        // the default plan without timing: the register tile by ICC_T of the SIMD vector of the translation unit
+        static Plan estimate() {
+            return {simd_vector_t<T>::size(), Strategy::tile, IccAlgorithm::rd, simd_vector_t<T>::size(), 0};
+        };
+
+        // bind a plan to a kernel, the default plan if it is not a candidate (e.g., a wisdom file of another build)
+        static kernel_t make(const Plan& p, const T (&coeffs)[N][5], const T (&inits)[N][4]) {
+            for (auto& c: _candidates()) {
+                if (c.plan.width == p.width && c.plan.strategy == p.strategy && c.plan.rows == p.rows && 
+                    (p.strategy != Strategy::tile || c.plan.icc == p.icc)) {
+                    return c.make(coeffs, inits);
+                }
+            }
+
+            return make(estimate(), coeffs, inits);
+        };
+
+        // key of a problem in the wisdom, e.g., float/instrset:8/N:6/len:4096. The instruction set is that of the CPU, not of
+        // the translation unit, since the same build times differently on machines of another instruction set.
+        static std::string key(const long len) {
+            static const int iset = instrset_detect();
+
+            return std::string(std::is_same_v<T, float> ? "float" : "double") + "/instrset:" + std::to_string(iset) +
+                   "/N:" + std::to_string(N) + "/len:" + std::to_string(std::bit_ceil((unsigned long)std::max(len, 1L)));
+        };
+
+        // time every candidate on a trunk of len samples (rounded up to a power of 2) of the filter, and return the fastest
+        static Plan measure(const T (&coeffs)[N][5], const long len) {
+            const long L = std::bit_ceil((unsigned long)std::max(len, 1L));
+            const T zeros[N][4] = {};
+
+            // white noise of a linear congruential generator, the decaying response of an impulse would run into denormals
+            std::vector<T> x(L), y(L);
+            unsigned int seed = 1;
+
+            for (auto& v: x) {
+                seed = seed*1664525u + 1013904223u;
+                v = T(seed >> 8)/T(1 << 24) - T(0.5);
+            }
+
+            Plan best = estimate();
+            best.ns_per_sample = INFINITY;
+
+            for (auto& c: _candidates()) {
+                kernel_t K = c.make(coeffs, zeros);
+                double t = _time(*K, x, y);
+
+                if (t < best.ns_per_sample) {
+                    best = c.plan;
+                    best.ns_per_sample = t;
+                }
+            }
+
+            return best;
+        };
+
+        // the plan of the wisdom, or measure it and save the wisdom on the first use
+        static Plan plan(const T (&coeffs)[N][5], const long len, Wisdom& wisdom) {
+            const std::string k = key(len);
+
+            if (const Plan* p = wisdom.find(k)) return *p;
+
+            Plan p = measure(coeffs, len);
+
+            wisdom.insert(k, p);
+            wisdom.save();
+
+            return p;
+        };
+};
+
+// the same interface as Filter, bound to the plan of the wisdom for trunks of about len samples at construction.
+template<typename T, int N> class PlannedFilter{
+
+    private:
+
+        Plan _plan;
+
+        std::unique_ptr<FilterKernel<T>> _K;
+
+    public:
+
+        // Parameterized constructor, plan for the typical length of trunks len, then initialize the filter of the plan
+        PlannedFilter(const T (&coeffs)[N][5], const T (&inits)[N][4], const long len, Wisdom& wisdom) {
+
+            _plan = Planner<T,N>::plan(coeffs, len, wisdom);
+            _K = Planner<T,N>::make(_plan, coeffs, inits);
+        };
+
+        // filter a trunk of any length by the path of the plan
+        inline T* operator()(const T* first, const T* last, T* d_first) {
+            return (*_K)(first, last, d_first);
+        };
+
+        inline void get_inits(T (&inits)[N][4]) {
+            _K->get_inits(inits);
+        };
+
+        inline void set_inits(const T (&inits)[N][4]) {
+            _K->set_inits(inits);
+        };
+
+        // the plan bound
+        inline const Plan& plan() const {
+            return _plan;
+        };
+
+        // name of the path bound, e.g., M:8/tile/icc_t
+        inline const char* name() const {
+            return _K->isa();
+        };
+};
+
+#endif // header guard
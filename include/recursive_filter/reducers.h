@@ -0,0 +1,131 @@
+#ifndef REDUCERS_H
+#define REDUCERS_H 1
+
+#include <array>
+#include <cmath>
+#include "simd_vector.h"
+
+/*
+    reducers of Filter::reduce, which are applied to each matrix Y^T of outputs while it stays in registers, so the
+    filtered signal is never written. A reducer is any callable r(const std::array<V,M>& y_T, int len), where y_T 
+    holds len valid samples (M*M but the last matrix of a trunk), the sample s at y_T[s%M][s/M] and zeros after len.
+ */
+
+// lane-wise minimum and maximum of vectors, out of Statistics whose min and max hide them
+template<typename V> inline V _min_lanes(const V& a, const V& b) {
+    return min(a, b);
+};
+
+template<typename V> inline V _max_lanes(const V& a, const V& b) {
+    return max(a, b);
+};
+
+// sum, sum of squares (energy), minimum and maximum of the outputs
+template<typename V> class Statistics{
+
+    // V: data type of SIMD vector. T: data type of values in SIMD vector
+    using T = decltype(std::declval<V>().extract(0));
+
+    // M: length of SIMD vector.
+    constexpr static int M = V::size();
+
+    // F: number of matrices accumulated in the vectors before folded into the sums in double
+    constexpr static int F = 64;
+
+    private:
+
+        // lane-wise accumulators of the recent matrices
+        V _sum{0}, _sum2{0}, _min{INFINITY}, _max{-INFINITY};
+
+        // the sums folded in double, which keeps the error of long trunks bounded
+        double _dsum = 0, _dsum2 = 0;
+
+        long _count = 0;
+
+        int _tiles = 0;
+
+        inline void _fold() {
+            _dsum += horizontal_add(_sum);
+            _dsum2 += horizontal_add(_sum2);
+            _sum = _sum2 = V(0);
+            _tiles = 0;
+        };
+
+    public:
+
+        // default constructor, no sample
+        Statistics(){};
+
+        // accumulate one matrix, the blocks are added lane-wise first, then to the accumulators
+        inline void operator()(const std::array<V,M>& y, const int len=M*M) {
+
+            if (len == M*M) {
+                V s = y[0], s2 = y[0]*y[0], lo = y[0], hi = y[0];
+
+                for (auto n=1; n<M; n++) {
+                    s += y[n];
+                    s2 = mul_add(y[n], y[n], s2);
+                    lo = _min_lanes(lo, y[n]);
+                    hi = _max_lanes(hi, y[n]);
+                }
+
+                _sum += s;
+                _sum2 += s2;
+                _min = _min_lanes(_min, lo);
+                _max = _max_lanes(_max, hi);
+
+                if (++_tiles == F) _fold();
+
+            } else {
+                // the last matrix of a trunk, zero padded: sample by sample
+                for (auto s=0; s<len; s++) {
+                    T v = y[s%M][s/M];
+
+                    _dsum += v;
+                    _dsum2 += double(v)*v;
+                    _min = _min_lanes(_min, V(v));
+                    _max = _max_lanes(_max, V(v));
+                }
+            }
+
+            _count += len;
+        };
+
+        // number of samples
+        inline long count() const {
+            return _count;
+        };
+
+        inline double sum() const {
+            return _dsum + horizontal_add(_sum);
+        };
+
+        // sum of squares
+        inline double energy() const {
+            return _dsum2 + horizontal_add(_sum2);
+        };
+
+        inline double mean() const {
+            return sum()/_count;
+        };
+
+        // root mean square
+        inline double rms() const {
+            return std::sqrt(energy()/_count);
+        };
+
+        inline T min() const {
+            return horizontal_min(_min);
+        };
+
+        inline T max() const {
+            return horizontal_max(_max);
+        };
+
+        // largest magnitude
+        inline T peak() const {
+            return std::max(-min(), max());
+        };
+};
+
+#endif // header guard
@@ -7,8 +7,9 @@
 #include "init_cond_correction.h"
 #include "permuteV.h"
 
-// different combinations of second order cores composed by zic and icc functions
-template<typename V> class IirCoreOrderTwo{
+// different combinations of second order cores composed by zic and icc functions. P: tables kept by icc, see IccTables.
+// K: rows of the tile of option 3 in cascaded system (option3_middle), M by default, see InitCondCorc.
+template<typename V, IccTables P = IccTables::lazy, int K = V::size()> class IirCoreOrderTwo{
 
     // V: data type of SIMD vector. T: data type of values in SIMD vector 
     using T = decltype(std::declval<V>().extract(0));
@@ -18,14 +19,14 @@ template<typename V> class IirCoreOrderTwo{
 
     private:
 
-        // coefficients of recursive equation: y_n = x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
-        T _b1, _b2, _a1, _a2; 
+        // coefficients of recursive equation: y_n = b_0x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
+        T _b0, _b1, _b2, _a1, _a2; 
 
         // state for zic 
         ZeroInitCond<V> _Zic;
         
         // state for icc
-        InitCondCorc<V> _Icc;
+        InitCondCorc<V,P,K> _Icc;
         
     public:
 
@@ -33,24 +34,38 @@ template<typename V> class IirCoreOrderTwo{
         IirCoreOrderTwo(){};
 
         // Parameterized constructor, initialize the coefficients and pre-conditions of both parts with seperated values.
-        IirCoreOrderTwo(const T b1, const T b2, const T a1, const T a2, const T xi1=0, const T xi2=0, const T yi1=0, const T yi2=0): 
-                        _b1(b1), _b2(b2), _a1(a1), _a2(a2) {
+        // the coefficients are passed to zic and icc in double for the pre-computations. The gain b_0 is 1.
+        IirCoreOrderTwo(const double b1, const double b2, const double a1, const double a2, const T xi1=0, const T xi2=0, const T yi1=0, const T yi2=0): 
+                        _b0(1), _b1(b1), _b2(b2), _a1(a1), _a2(a2) {
 
                             // initialize the state of particular part.
-                            _Zic = ZeroInitCond<V>(_b1, _b2, _a1, _a2, xi1, xi2); 
+                            _Zic = ZeroInitCond<V>(1, b1, b2, a1, a2, xi1, xi2); 
 
                             // initialize the state of homogeneous part.
-                            _Icc = InitCondCorc<V>(_a1, _a2, yi1, yi2); 
+                            _Icc = InitCondCorc<V,P,K>(a1, a2, yi1, yi2); 
                         };
 
-        // Overloaded constructor, initialize the coefficients and pre-conditions of both parts with a vector of values. 
-        IirCoreOrderTwo(const T coefs[5], const T inits[4]): _b1(coefs[1]), _b2(coefs[2]), _a1(coefs[3]), _a2(coefs[4]) {
+        // Overloaded constructor, initialize the coefficients [b_0, b_1, b_2, a_1, a_2] and pre-conditions of both parts with a vector of values in T or double. 
+        template<typename U> IirCoreOrderTwo(const U coefs[5], const U inits[4]): _b0(coefs[0]), _b1(coefs[1]), _b2(coefs[2]), _a1(coefs[3]), _a2(coefs[4]) {
 
-            // initialize the state of particular part.
-            _Zic = ZeroInitCond<V>(coefs[1], coefs[2], coefs[3], coefs[4], inits[0], inits[1]); 
+            // initialize the state of particular part, the gain b_0 is folded into its pre-computed matrices.
+            _Zic = ZeroInitCond<V>(coefs[0], coefs[1], coefs[2], coefs[3], coefs[4], inits[0], inits[1]); 
 
             // initialize the state of homogeneous part.
-            _Icc = InitCondCorc<V>(coefs[3], coefs[4], inits[2], inits[3]); 
+            _Icc = InitCondCorc<V,P,K>(coefs[3], coefs[4], inits[2], inits[3]); 
+        };
+
+
+        // read the pre-conditions of both parts in the same order as the constructor: x_{-1}, x_{-2}, y_{-1}, y_{-2}.
+        inline void get_inits(T inits[4]) {
+            _Zic.get_inits(inits[0], inits[1]);
+            _Icc.get_inits(inits[2], inits[3]);
+        };
+
+        // overwrite the pre-conditions of both parts.
+        inline void set_inits(const T inits[4]) {
+            _Zic.set_inits(inits[0], inits[1]);
+            _Icc.set_inits(inits[2], inits[3]);
         };
 
 
@@ -66,7 +81,9 @@ template<typename V> class IirCoreOrderTwo{
                 option2_tail: the mat transpose at the head of option 2 is cancelled
                 option3_head: the mat transpose at the tail of option 3 is cancelled
                 option3_tail: the mat transpose at the head of option 3 is cancelled
-                option3_middle: the mat transposes at head and tail of option 3 are cancelled
+                option3_middle: the mat transposes at head and tail of option 3 are cancelled, on the tile of K rows
+                option3_middle_inplace: option3_middle on a tile owned by the caller, without copies
+                option3_stuffed_head: the head of an interpolating cascade, the zic of the zero stuffed input by block filtering
 
          */
 
@@ -84,10 +101,10 @@ template<typename V> class IirCoreOrderTwo{
             return y;
         };
 
-        // the option 1, block filtering: ZIC_NT - ICC_NT 
-        inline V option1(const V x) {
+        // the option 1, block filtering: ZIC_NT - ICC_NT. A: ZIC_NT by the Toeplitz matrix or in log_2(M) steps (ZIC_NT_RD).
+        template<ZicAlgorithm A = ZicAlgorithm::toeplitz> inline V option1(const V x) {
 
-            V w = _Zic.ZIC_NT(x);
+            V w = _Zic.template ZIC_NT_by<A>(x);
             V y = _Icc.ICC_NT(w);
 
             return y;
@@ -107,7 +124,7 @@ template<typename V> class IirCoreOrderTwo{
         };
 
         // the option 3, multi-block filtering: T - ZIC_T - ICC_T - T
-        inline std::array<V,M> option3(const std::array<V,M>& x) {
+        inline std::array<V,M> option3(const std::array<V,M>& x) requires (K == M) {
 
             std::array<V,M> x_T = _permuteV(x);
             std::array<V,M> w_T = _Zic.ZIC_T(x_T);
@@ -134,7 +151,7 @@ template<typename V> class IirCoreOrderTwo{
         };
 
         // option 3 at the head in cas system. The mat transpose at the tail can be cancelled by another MT at the head of next core
-        inline std::array<V,M> option3_head(const std::array<V,M>& x) {
+        inline std::array<V,M> option3_head(const std::array<V,M>& x) requires (K == M) {
 
             std::array<V,M> x_T = _permuteV(x);
             std::array<V,M> w_T = _Zic.ZIC_T(x_T);
@@ -144,7 +161,7 @@ template<typename V> class IirCoreOrderTwo{
         };
 
         // option 3 at the tail in cas system. The mat transpose at the head can be cancelled by another MT at the tail of previous core
-        inline std::array<V,M> option3_tail(const std::array<V,M>& x_T) {
+        inline std::array<V,M> option3_tail(const std::array<V,M>& x_T) requires (K == M) {
 
             std::array<V,M> w_T = _Zic.ZIC_T(x_T);
             std::array<V,M> y_T = _Icc.ICC_T(w_T);
@@ -154,14 +171,48 @@ template<typename V> class IirCoreOrderTwo{
         };
 
         // option 3 at the middle in cas system. The mat transpose at the head and tail can both be cancelled.
-        inline std::array<V,M> option3_middle(const std::array<V,M>& x_T) {
+        // len: number of valid samples when the matrix is a zero padded remainder.
+        inline std::array<V,K> option3_middle(const std::array<V,K>& x_T, const int len=M*K) {
 
-            std::array<V,M> w_T = _Zic.ZIC_T(x_T);
-            std::array<V,M> y_T = _Icc.ICC_T(w_T);
+            std::array<V,K> w_T = _Zic.ZIC_T(x_T, len);
+            std::array<V,K> y_T = _Icc.ICC_T(w_T, len);
 
             return y_T;
         };
 
+        // option 3 at the middle in cas system working on the caller-owned tile by reference: X^T is overwritten by Y^T.
+        // row0, step: the blocks of Y^T forwarded by ICC_T, see InitCondCorc::ICC_T_kernel. A: algorithm of icc.
+        template<IccAlgorithm A = IccAlgorithm::rd> inline void option3_middle_inplace(std::array<V,K>& x_T, const int len=M*K, 
+                                                                                      const int row0=0, const int step=1) {
+
+            _Zic.ZIC_T_inplace(x_T, len);
+
+            if constexpr (A == IccAlgorithm::rd) _Icc.ICC_T_inplace(x_T, len, row0, step);
+            else _Icc.template ICC_T_inplace_by<A>(x_T, len);
+        };
+
+        /* 
+            option 3 at the head in cas system of interpolation, the M*M samples of the input upsampled by L in one matrix:
+            the low rate samples from x sit at the positions ph, ph+L, ... (0 <= ph < L) and the others are zeros.
+            W is formed block by block by ZIC_NT_stuffed, transposed, then ICC_T writes Y^T into the caller-owned tile y_T.
+            returns the iterator after the low rate samples consumed.
+         */
+        template<typename InputIt> inline InputIt option3_stuffed_head(std::array<V,M>& y_T, InputIt x, int ph, const int L) requires (K == M) {
+
+            for (auto n=0; n<M; n++) {
+                y_T[n] = _Zic.ZIC_NT_stuffed(x, ph, L, n == 0);
+
+                // the samples of this block and the position of the next sample in the next block
+                for (; ph<M; ph+=L) ++x;
+                ph -= M;
+            }
+
+            _permuteV_inplace(y_T);
+            _Icc.ICC_T_inplace(y_T);
+
+            return x;
+        };
+
 };
 
 #endif // header guard 
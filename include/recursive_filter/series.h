@@ -13,13 +13,23 @@ template<typename... Types> class Series{
         // tuple of second order cores
         std::tuple<Types...> _t; 
 
+        // cascaded function of scalar
+        template<int i, typename U> inline U _proc_scalar(const U x) {
+            if constexpr (i >= std::tuple_size<decltype(_t)>::value) {
+                return x;          
+            } else {
+                U r = std::get<i>(_t).benchmark(x);
+                return _proc_scalar<i+1>(r);  
+            };
+        };
+
         // cascaded function of option 1
-        template<int i, typename U> inline U _proc_option1(const U& x) {
+        template<int i, ZicAlgorithm A = ZicAlgorithm::toeplitz, typename U> inline U _proc_option1(const U& x) {
             if constexpr (i >= std::tuple_size<decltype(_t)>::value) {
                 return x;          
             } else {
-                U r = std::get<i>(_t).option1(x);
-                return _proc_option1<i+1>(r);  
+                U r = std::get<i>(_t).template option1<A>(x);
+                return _proc_option1<i+1,A>(r);  
             };
         };
 
@@ -42,6 +52,68 @@ template<typename... Types> class Series{
                 return _proc_option3<i+1>(r);  
             };
         };
+
+        // cascaded function of option 3 for a zero padded matrix with len valid samples
+        template<int i, typename U> inline U _proc_option3(const U& x, const int len) {
+            if constexpr (i >= std::tuple_size<decltype(_t)>::value) {
+                return x;          
+            } else {
+                U r = std::get<i>(_t).option3_middle(x, len);
+                return _proc_option3<i+1>(r, len);  
+            };
+        };
+        
+        // number of samples in a whole tile of K rows (std::array<V,K>), i.e., M*K
+        template<typename U> static constexpr int _samples(const U& x) {
+            return x.size()*U::value_type::size();
+        };
+
+        // cascaded function of option 3 on one tile in place, by the algorithm A of icc
+        template<int i, IccAlgorithm A = IccAlgorithm::rd, typename U> inline void _proc_option3_inplace(U& x, const int len) {
+            if constexpr (i < std::tuple_size<decltype(_t)>::value) {
+                std::get<i>(_t).template option3_middle_inplace<A>(x, len);
+                _proc_option3_inplace<i+1, A>(x, len);  
+            };
+        };
+
+        // cascaded function of option 3 on one tile in place, the last core forwards the blocks row0, row0+step, ... only
+        template<int i, typename U> inline void _proc_option3_rows_inplace(U& x, const int row0, const int step) {
+            constexpr int n = std::tuple_size<decltype(_t)>::value;
+
+            if constexpr (i < n - 1) {
+                std::get<i>(_t).option3_middle_inplace(x, _samples(x));
+                _proc_option3_rows_inplace<i+1>(x, row0, step);  
+            } else if constexpr (i == n - 1) {
+                std::get<i>(_t).option3_middle_inplace(x, _samples(x), row0, step);
+            };
+        };
+
+        // one step of the wavefront: the i-th core filters the tile t-i of the ring, if it is one of the tiles 0 ... count-1
+        template<int i, typename U, size_t D> inline void _proc_wavefront(std::array<U,D>& ring, const long t, const long count) {
+            if constexpr (i < std::tuple_size<decltype(_t)>::value) {
+                if (t - i >= 0 && t - i < count) {
+                    U& x = ring[(t - i)%D];
+                    std::get<i>(_t).option3_middle_inplace(x, _samples(x));
+                }
+                _proc_wavefront<i+1>(ring, t, count);
+            };
+        };
+
+        // read the pre-conditions of each core
+        template<int i, typename T> inline void _get_inits(T (*inits)[4]) {
+            if constexpr (i < std::tuple_size<decltype(_t)>::value) {
+                std::get<i>(_t).get_inits(inits[i]);
+                _get_inits<i+1>(inits);
+            };
+        };
+
+        // overwrite the pre-conditions of each core
+        template<int i, typename T> inline void _set_inits(const T (*inits)[4]) {
+            if constexpr (i < std::tuple_size<decltype(_t)>::value) {
+                std::get<i>(_t).set_inits(inits[i]);
+                _set_inits<i+1>(inits);
+            };
+        };
         
     public:
 
@@ -51,9 +123,24 @@ template<typename... Types> class Series{
         // Parameterized constructor, initialize a tuple of second order cores 
         Series(Types...types): _t(types...){};
 
-        // pass one vector of samples into cascaded higher order filter of option 1
-        template<typename U> inline U series_option1(const U& x) { 
-            return _proc_option1<0>(x); 
+        // read the pre-conditions of all cores, inits[i] = [x_{-1}, x_{-2}, y_{-1}, y_{-2}] of the i-th core
+        template<typename T> inline void get_inits(T (*inits)[4]) {
+            _get_inits<0>(inits);
+        };
+
+        // overwrite the pre-conditions of all cores
+        template<typename T> inline void set_inits(const T (*inits)[4]) {
+            _set_inits<0>(inits);
+        };
+
+        // pass one sample into cascaded higher order filter of scalar
+        template<typename U> inline U series_scalar(const U x) { 
+            return _proc_scalar<0>(x); 
+        };
+
+        // pass one vector of samples into cascaded higher order filter of option 1, A: see ZicAlgorithm
+        template<ZicAlgorithm A = ZicAlgorithm::toeplitz, typename U> inline U series_option1(const U& x) { 
+            return _proc_option1<0,A>(x); 
         };
 
         // pass one matrix of samples into cascaded higher order filter of option 2
@@ -66,6 +153,52 @@ template<typename... Types> class Series{
             return _proc_option3<0>(x); 
         };
 
+        // pass one partial matrix (len valid samples, zero padded) into cascaded higher order filter of option 3
+        template<typename U> inline U series_option3(const U& x, const int len) { 
+            return _proc_option3<0>(x, len); 
+        };
+
+        // pass one caller-owned matrix (the register tile) into cascaded higher order filter of option 3 in place, A: algorithm of icc
+        template<IccAlgorithm A = IccAlgorithm::rd, typename U> inline void series_option3_inplace(U& x) { 
+            _proc_option3_inplace<0, A>(x, _samples(x)); 
+        };
+
+        // pass one caller-owned partial matrix (len valid samples, zero padded) into cascaded higher order filter of option 3 in place
+        template<typename U> inline void series_option3_inplace(U& x, const int len) { 
+            _proc_option3_inplace<0>(x, len); 
+        };
+
+        /* 
+            one step of the cascade of option 3 pipelined across the cores (wavefront) over a caller-owned ring of tiles: at 
+            step t the i-th core filters the tile t-i held in ring[(t-i)%D], i.e., the core i+1 works on the tile that the core
+            i finished at the step before. The cores of one step work on different tiles, thus the serial chains of ZIC_T and 
+            ICC_T of neighbouring cores are independent and overlap in the out-of-order core, instead of each core waiting on 
+            the latency of the one before on the same tile. The caller loads the tile t into ring[t%D] before the step, and
+            the tile t-n+1 (n cores) is complete after it, thus D >= n tiles are in flight. count: number of tiles of the trunk,
+            the steps count to count+n-2 drain the pipeline.
+         */
+        template<typename U, size_t D> inline void series_option3_wavefront(std::array<U,D>& ring, const long t, const long count) { 
+            static_assert(D >= sizeof...(Types), "the ring holds a tile for each core");
+
+            _proc_wavefront<0>(ring, t, count); 
+        };
+
+        // pass M*M samples of the input upsampled by L (the low rate samples from x at the positions ph, ph+L, ...) into cascaded 
+        // higher order filter of option 3, Y^T is written to the caller-owned matrix y. Returns the iterator after the samples consumed.
+        template<typename U, typename InputIt> inline InputIt series_option3_stuffed(U& y, InputIt x, const int ph, const int L) { 
+            x = std::get<0>(_t).option3_stuffed_head(y, x, ph, L);
+            _proc_option3_inplace<1>(y, _samples(y));
+
+            return x;
+        };
+
+        // pass one caller-owned matrix into cascaded higher order filter of option 3 in place, where only the blocks row0, 
+        // row0+step, ... (and the last two) of the output Y^T are required, e.g., by the decimation. The pre-conditions
+        // are carried over exactly as series_option3_inplace.
+        template<typename U> inline void series_option3_rows_inplace(U& x, const int row0, const int step) { 
+            _proc_option3_rows_inplace<0>(x, row0, step); 
+        };
+
 };
 
 
@@ -89,15 +222,15 @@ template <class... Types> constexpr Series<unwrap_decay_t<Types>...> make_series
     return Series<unwrap_decay_t<Types>...>(std::forward<Types>(args)...);
 };
 
-template<typename V, typename Array1, typename Array2, std::size_t... I>
+template<typename V, IccTables P, int K, typename Array1, typename Array2, std::size_t... I>
 auto make_series_from_coeffs(const Array1& coefs, const Array2& inits, std::index_sequence<I...>) {
-    using Class = IirCoreOrderTwo<V>;
+    using Class = IirCoreOrderTwo<V,P,K>;
     return make_series(Class(coefs[I], inits[I])...); 
 };
 
-template<typename T, typename V, size_t N, typename indices = std::make_index_sequence<N>>
+template<typename T, typename V, IccTables P = IccTables::lazy, int K = V::size(), size_t N, typename indices = std::make_index_sequence<N>>
 auto series_from_coeffs(const T (&coefs)[N][5], const T (&inits)[N][4]={0}) { 
-    return make_series_from_coeffs<V>(coefs, inits, indices{});
+    return make_series_from_coeffs<V,P,K>(coefs, inits, indices{});
 };
 
 #endif // header guard 
@@ -2,6 +2,7 @@
 #define SHIFT_REG_H 1
 
 #include "vectorclass.h"
+#include "lane_patterns.h"
 #include <utility>
 
 // shift register that stores the pre-conditions of recursive filter for current blocks of data 
@@ -22,21 +23,8 @@ template<typename V> class Shift{
 
         // scalar shift
         inline void shift(const T x) {
-            // SSE
-            if constexpr (M == 4) {
-                // left shift buffer by 1 and add scalar at the end
-                _buffer = blend4<1,2,3,4>(_buffer, x); 
-            }
-            
-            // AVX2
-            if constexpr (M == 8) {
-                _buffer = blend8<1,2,3,4,5,6,7,8>(_buffer, x); 
-            }
-            
-            // AVX512
-            if constexpr (M == 16) {
-                _buffer = blend16<1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16>(_buffer, x);
-            }
+            // left shift buffer by 1 and add scalar at the end
+            _buffer = _shift_outV(_buffer, x);
         }; 
             
         // vector shift, simply copy vector in buffer thus faster than scalar shift.
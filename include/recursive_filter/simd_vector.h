@@ -0,0 +1,32 @@
+#ifndef SIMD_VECTOR_H
+#define SIMD_VECTOR_H 1
+
+#include <type_traits>
+#include "vectorclass.h"
+
+// vectorclass wrapped in a namespace, e.g., one namespace per instruction set in runtime dispatch.
+#ifdef VCL_NAMESPACE
+using namespace VCL_NAMESPACE;
+#endif
+
+// select the vector length and type based on the requested instruction set (of the translation unit) and the type T
+#if INSTRSET >= 9  // AVX512
+    template<typename T> using simd_vector_t = typename std::conditional<std::is_same<T, float>::value, Vec16f, Vec8d>::type;
+#elif INSTRSET >= 7  // AVX2
+    template<typename T> using simd_vector_t = typename std::conditional<std::is_same<T, float>::value, Vec8f, Vec4d>::type;
+#else // SSE
+    template<typename T> using simd_vector_t = typename std::conditional<std::is_same<T, float>::value, Vec4f, Vec2d>::type;
+#endif
+
+// load M values pre-computed in double precision into a vector of T, rounded once.
+template<typename V> inline V load_rounded(const double* p) {
+    decltype(std::declval<V>().extract(0)) buf[V::size()];
+    V v;
+
+    for (auto n=0; n<V::size(); n++) buf[n] = p[n];
+    v.load(buf);
+
+    return v;
+};
+
+#endif // header guard
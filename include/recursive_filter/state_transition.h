@@ -0,0 +1,112 @@
+#ifndef STATE_TRANSITION_H
+#define STATE_TRANSITION_H 1
+
+#include <vector>
+
+/*
+    state transition of cascaded second order sections under zero input. The state of the i-th section is
+    s[i] = [x_{-1}, x_{-2}, y_{-1}, y_{-2}] as the inits of the filter, and the whole state is a vector of 4N elements.
+    A: transition of one sample. P = A^L: transition of L samples, which is obtained by the recursive squaring of A,
+    the same way of C, C^2, C^4 ... in recursive doubling but across the sections. Computed in double precision.
+ */
+template<int N> class StateTransition{
+
+    // D: dimension of the state vector.
+    constexpr static int D = 4*N;
+
+    private:
+
+        // coefficients of recursive equation of each section: y_n = b_0x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
+        double _b0[N], _b1[N], _b2[N], _a1[N], _a2[N];
+
+        // D by D transition matrices in row major: A of one sample, P of L samples.
+        std::vector<double> _A, _P;
+
+        // advance the state by one sample of zero input
+        inline void _step(double s[D]) {
+            double x = 0, y;
+
+            for (auto i=0; i<N; i++) {
+                double* si = s + 4*i;
+
+                y = _b0[i]*x + _b1[i]*si[0] + _b2[i]*si[1] + _a1[i]*si[2] + _a2[i]*si[3];
+
+                si[1] = si[0];
+                si[0] = x;
+                si[3] = si[2];
+                si[2] = y;
+
+                // output of the i-th section is the input of the next one
+                x = y;
+            }
+        };
+
+        // C = A*B of D by D matrices
+        static inline std::vector<double> _mul(const std::vector<double>& A, const std::vector<double>& B) {
+            std::vector<double> C(D*D, 0);
+
+            for (auto r=0; r<D; r++)
+                for (auto k=0; k<D; k++)
+                    for (auto c=0; c<D; c++) C[r*D+c] += A[r*D+k]*B[k*D+c];
+
+            return C;
+        };
+
+    public:
+
+        // default constructor
+        StateTransition(){};
+
+        // Parameterized constructor, build the transition matrix of one sample from the array of coefficients.
+        template<typename T> StateTransition(const T (&coeffs)[N][5]): _A(D*D, 0) {
+
+            for (auto i=0; i<N; i++) {
+                _b0[i] = coeffs[i][0];
+                _b1[i] = coeffs[i][1];
+                _b2[i] = coeffs[i][2];
+                _a1[i] = coeffs[i][3];
+                _a2[i] = coeffs[i][4];
+            }
+
+            // the j-th column of A is the transition of the j-th unit state
+            for (auto j=0; j<D; j++) {
+                double e[D] = {0};
+                e[j] = 1;
+
+                _step(e);
+
+                for (auto r=0; r<D; r++) _A[r*D+j] = e[r];
+            }
+
+            power(1);
+        };
+
+        // pre-compute P = A^L by recursive squaring, log_2(L) matrix multiplications.
+        inline void power(long L) {
+            std::vector<double> B = _A;
+
+            // identity
+            _P.assign(D*D, 0);
+            for (auto r=0; r<D; r++) _P[r*D+r] = 1;
+
+            while (L > 0) {
+                if (L & 1) _P = _mul(_P, B);
+                L >>= 1;
+                if (L > 0) B = _mul(B, B);
+            }
+        };
+
+        // forward the state over L samples of zero input and accumulate: r += P*s.
+        template<typename T> inline void forward(const T (*s)[4], T (*r)[4]) {
+            for (auto i=0; i<D; i++) {
+                double acc = r[i/4][i%4];
+
+                for (auto j=0; j<D; j++) acc += _P[i*D+j]*s[j/4][j%4];
+
+                r[i/4][i%4] = acc;
+            }
+        };
+
+};
+
+#endif // header guard
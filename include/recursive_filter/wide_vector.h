@@ -0,0 +1,285 @@
+#ifndef WIDE_VECTOR_H
+#define WIDE_VECTOR_H 1
+
+#include <array>
+#include <algorithm>
+#include "vectorclass.h"
+#include "simd_vector.h"
+#include "lane_patterns.h"
+#include "permuteV.h"
+
+/*
+    composite vector of G native registers of vectorclass, i.e., a logical vector of M = G*V::size() lanes, e.g.,
+    WideVec<Vec8f,2> of 16 lanes on AVX2. Passed as V to the cores (and Filter, Series ...), the lanes run 2 or 4 times
+    as many independent chains of FMA in ZIC_T and ICC_T, and the recursive doubling one more level per doubling,
+    at the cost of G times the registers of a tile. The lane i is the lane i%V::size() of the register i/V::size().
+    The shuffles of the kernels (see lane_patterns.h) are split into the native permutes and blends of one or two
+    registers at compile time, and the transposes into the transposes of the native M by M blocks.
+ */
+template<typename V, int G> class WideVec{
+
+    // V: data type of native SIMD vector. T: data type of values in SIMD vector
+    using T = decltype(std::declval<V>().extract(0));
+
+    // m: length of native SIMD vector.
+    constexpr static int m = V::size();
+
+    static_assert(G == 2 || G == 4, "a composite vector of 2 or 4 native registers");
+
+    private:
+
+        // the native registers, lanes m*g to m*g+m-1 in the g-th register
+        V _r[G];
+
+    public:
+
+        // length of the logical vector
+        static constexpr int size() { return G*m; };
+
+        // default constructor
+        WideVec(){};
+
+        // broadcast a scalar to all the lanes
+        WideVec(const T s) {
+            for (auto g=0; g<G; g++) _r[g] = V(s);
+        };
+
+        // the g-th native register
+        inline V& reg(const int g) { return _r[g]; };
+        inline const V& reg(const int g) const { return _r[g]; };
+
+        inline WideVec& load(const T* p) {
+            for (auto g=0; g<G; g++) _r[g].load(p + g*m);
+            return *this;
+        };
+
+        inline WideVec& load_a(const T* p) {
+            for (auto g=0; g<G; g++) _r[g].load_a(p + g*m);
+            return *this;
+        };
+
+        // load the first n lanes, the others are zeros
+        inline WideVec& load_partial(const int n, const T* p) {
+            for (auto g=0; g<G; g++) {
+                const int k = std::min(std::max(n - g*m, 0), m);
+
+                if (k == m) _r[g].load(p + g*m);
+                else if (k > 0) _r[g].load_partial(k, p + g*m);
+                else _r[g] = V(0);
+            }
+            return *this;
+        };
+
+        inline void store(T* p) const {
+            for (auto g=0; g<G; g++) _r[g].store(p + g*m);
+        };
+
+        inline void store_a(T* p) const {
+            for (auto g=0; g<G; g++) _r[g].store_a(p + g*m);
+        };
+
+        inline void store_nt(T* p) const {
+            for (auto g=0; g<G; g++) _r[g].store_nt(p + g*m);
+        };
+
+        // store the first n lanes
+        inline void store_partial(const int n, T* p) const {
+            for (auto g=0; g<G; g++) {
+                const int k = std::min(std::max(n - g*m, 0), m);
+
+                if (k == m) _r[g].store(p + g*m);
+                else if (k > 0) _r[g].store_partial(k, p + g*m);
+            }
+        };
+
+        inline T extract(const int i) const { return _r[i/m].extract(i%m); };
+
+        inline T operator[](const int i) const { return extract(i); };
+
+        inline WideVec& insert(const int i, const T s) {
+            _r[i/m].insert(i%m, s);
+            return *this;
+        };
+
+        // lane-wise arithmetic, register by register
+        friend inline WideVec operator+(const WideVec& a, const WideVec& b) {
+            WideVec c;
+            for (auto g=0; g<G; g++) c._r[g] = a._r[g] + b._r[g];
+            return c;
+        };
+
+        friend inline WideVec operator-(const WideVec& a, const WideVec& b) {
+            WideVec c;
+            for (auto g=0; g<G; g++) c._r[g] = a._r[g] - b._r[g];
+            return c;
+        };
+
+        friend inline WideVec operator*(const WideVec& a, const WideVec& b) {
+            WideVec c;
+            for (auto g=0; g<G; g++) c._r[g] = a._r[g] * b._r[g];
+            return c;
+        };
+
+        friend inline WideVec operator/(const WideVec& a, const WideVec& b) {
+            WideVec c;
+            for (auto g=0; g<G; g++) c._r[g] = a._r[g] / b._r[g];
+            return c;
+        };
+
+        friend inline WideVec operator-(const WideVec& a) {
+            WideVec c;
+            for (auto g=0; g<G; g++) c._r[g] = -a._r[g];
+            return c;
+        };
+
+        inline WideVec& operator+=(const WideVec& b) { return *this = *this + b; };
+        inline WideVec& operator-=(const WideVec& b) { return *this = *this - b; };
+        inline WideVec& operator*=(const WideVec& b) { return *this = *this * b; };
+        inline WideVec& operator/=(const WideVec& b) { return *this = *this / b; };
+
+        friend inline WideVec mul_add(const WideVec& a, const WideVec& b, const WideVec& c) {
+            WideVec d;
+            for (auto g=0; g<G; g++) d._r[g] = mul_add(a._r[g], b._r[g], c._r[g]);
+            return d;
+        };
+
+        friend inline WideVec min(const WideVec& a, const WideVec& b) {
+            WideVec c;
+            for (auto g=0; g<G; g++) c._r[g] = min(a._r[g], b._r[g]);
+            return c;
+        };
+
+        friend inline WideVec max(const WideVec& a, const WideVec& b) {
+            WideVec c;
+            for (auto g=0; g<G; g++) c._r[g] = max(a._r[g], b._r[g]);
+            return c;
+        };
+
+        // horizontal reductions, the registers reduced lane-wise first
+        friend inline T horizontal_add(const WideVec& a) {
+            V s = a._r[0];
+            for (auto g=1; g<G; g++) s += a._r[g];
+            return horizontal_add(s);
+        };
+
+        friend inline T horizontal_min(const WideVec& a) {
+            V s = a._r[0];
+            for (auto g=1; g<G; g++) s = min(s, a._r[g]);
+            return horizontal_min(s);
+        };
+
+        friend inline T horizontal_max(const WideVec& a) {
+            V s = a._r[0];
+            for (auto g=1; g<G; g++) s = max(s, a._r[g]);
+            return horizontal_max(s);
+        };
+
+};
+
+// the j-th native register of a pattern P over the lanes of the registers of m lanes: the (at most two) source registers g1, g2
+// and the native pattern, which counts the lanes of g2 after the lanes of g1.
+template<typename P, int m, int j> struct _NativePattern {
+
+    // the k-th distinct source register of the lanes m*j to m*j+m-1, -1 if none
+    static constexpr int source(const int k) {
+        int found[3] = {-1, -1, -1}, count = 0;
+
+        for (auto i=0; i<m; i++) {
+            const int s = P::at(m*j + i);
+            bool seen = false;
+
+            if (s < 0) continue;
+            for (auto c=0; c<count; c++) seen = seen || (found[c] == s/m);
+            if (!seen && count < 3) found[count++] = s/m;
+        }
+
+        return found[k];
+    };
+
+    static constexpr int g1 = source(0), g2 = source(1);
+
+    static_assert(source(2) == -1, "a native register takes the lanes of two source registers at most");
+
+    static constexpr int at(const int i) {
+        const int s = P::at(m*j + i);
+
+        return (s < 0) ? -1 : (s/m == g1 ? s%m : m + s%m);
+    };
+};
+
+// the j-th register of the result from the registers r of the sources by the pattern P
+template<typename P, int j, typename V, size_t S> inline V _native_shuffle(const std::array<V,S>& r) {
+    using Q = _NativePattern<P, V::size(), j>;
+
+    if constexpr (Q::g1 < 0) return V(0);
+    else if constexpr (Q::g2 < 0) return _permute_as<Q>(r[Q::g1]);
+    else return _blend_as<Q>(r[Q::g1], r[Q::g2]);
+};
+
+// permute the lanes of the composite vector a by the pattern P, register by register
+template<typename P, typename V, int G> inline WideVec<V,G> _permute_as(const WideVec<V,G>& a) {
+    std::array<V,G> r;
+    WideVec<V,G> c;
+
+    for (auto g=0; g<G; g++) r[g] = a.reg(g);
+
+    _static_for<G>([&](auto j) { c.reg(j) = _native_shuffle<P, decltype(j)::value>(r); });
+
+    return c;
+};
+
+// blend the lanes of the composite vectors a and b by the pattern P, the registers of b after those of a
+template<typename P, typename V, int G> inline WideVec<V,G> _blend_as(const WideVec<V,G>& a, const WideVec<V,G>& b) {
+    std::array<V,2*G> r;
+    WideVec<V,G> c;
+
+    for (auto g=0; g<G; g++) {
+        r[g] = a.reg(g);
+        r[G+g] = b.reg(g);
+    }
+
+    _static_for<G>([&](auto j) { c.reg(j) = _native_shuffle<P, decltype(j)::value>(r); });
+
+    return c;
+};
+
+/*
+    matrix transpose of the composite vectors in place, by G*G native blocks of m by m: the block (i,j), i.e., the rows
+    m*i to m*i+m-1 of the j-th register, is transposed into the block (j,i). The two blocks of each pair are read before
+    they are written.
+ */
+template<typename V, int G> inline void _permuteV_inplace(std::array<WideVec<V,G>,G*V::size()>& matrix) {
+    constexpr int m = V::size();
+    std::array<V,m> a, b;
+
+    for (auto i=0; i<G; i++) {
+        for (auto j=i; j<G; j++) {
+            for (auto k=0; k<m; k++) {
+                a[k] = matrix[m*i + k].reg(j);
+                b[k] = matrix[m*j + k].reg(i);
+            }
+
+            _permuteV_inplace(a);
+            _permuteV_inplace(b);
+
+            for (auto k=0; k<m; k++) {
+                matrix[m*j + k].reg(i) = a[k];
+                matrix[m*i + k].reg(j) = b[k];
+            }
+        }
+    }
+};
+
+// matrix transpose of the composite vectors
+template<typename V, int G> inline std::array<WideVec<V,G>,G*V::size()> _permuteV(const std::array<WideVec<V,G>,G*V::size()>& matrix) {
+    std::array<WideVec<V,G>,G*V::size()> matrix_T = matrix;
+
+    _permuteV_inplace(matrix_T);
+
+    return matrix_T;
+};
+
+// composite vector of G native vectors of T selected by the instruction set, e.g., wide_vector_t<float,2> of 16 lanes on AVX2.
+template<typename T, int G> using wide_vector_t = WideVec<simd_vector_t<T>, G>;
+
+#endif // header guard
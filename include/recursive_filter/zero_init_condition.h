@@ -2,8 +2,15 @@
 #define ZERO_INIT_CONDITION_H 1
 
 #include <array>
+#include <bit>
 #include "vectorclass.h"
+#include "simd_vector.h"
 #include "shift_reg.h"
+#include "lane_patterns.h"
+
+// algorithms of the particular part in block filtering: ZIC_NT (the Toeplitz matrix H, M FMAs per vector) and ZIC_NT_RD 
+// (the FIR part, then log_2(M) steps of shift and FMA), selected at compile time.
+enum class ZicAlgorithm { toeplitz, rd };
 
 // zero initial condition that calculates the particular part of recursive equation.
 template<typename V> class ZeroInitCond{
@@ -14,10 +21,17 @@ template<typename V> class ZeroInitCond{
     // M: length of SIMD vector.
     constexpr static int M = V::size(); 
 
+    // R: steps of ZIC_NT_RD, i.e., log_2(M).
+    constexpr static int R = std::bit_width(unsigned(M)) - 1;
+
     private:
 
-        // coefficients of recursive equation: y_n = x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
-        T _b1, _b2, _a1, _a2; 
+        // coefficients of recursive equation: y_n = b_0x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
+        T _b0, _b1, _b2, _a1, _a2; 
+
+        // the rounding errors of a_1 and a_2 in T, i.e., a_1 - _a1 and a_2 - _a2 of the coefficients in double. Zero unless 
+        // the coefficients are given in double to a core of float (mixed precision), see ZIC_T_kernel.
+        T _a1_lo, _a2_lo;
 
         // shift register inside zic storing the pre-condition of particular part, i.e., x_{-1}, x_{-2}.
         Shift<V> _S;
@@ -28,23 +42,46 @@ template<typename V> class ZeroInitCond{
         // M by M matrix works for block filtering.
         std::array<V,M> _H;
 
+        // coefficients of the steps of ZIC_NT_RD, the k-th step multiplies by 1 + _g1[k]z^{-d} + _g2[k]z^{-2d}, d=2^k.
+        T _g1[R], _g2[R];
+
     public:
 
         // default constructor
         ZeroInitCond(){};
 
-        // Parameterized constructor, initialize the particular part of recursive equation, including the coefficients and pre-conditions
-        ZeroInitCond(const T b1, const T b2, const T a1, const T a2, const T xi1=0, const T xi2=0): _b1(b1), _b2(b2), _a1(a1), _a2(a2) {
+        /* 
+            Parameterized constructor, initialize the particular part of recursive equation, including the coefficients and pre-conditions.
+            the coefficients are taken in double, and the pre-computations are done in double and rounded to T once.
+         */
+        ZeroInitCond(const double b0, const double b1, const double b2, const double a1, const double a2, const T xi1=0, const T xi2=0): 
+                     _b0(b0), _b1(b1), _b2(b2), _a1(a1), _a2(a2), _a1_lo(a1 - double(T(a1))), _a2_lo(a2 - double(T(a2))) {
 
             // initialize the pre-conditions of the particular part: x_{-2}, x_{-1}.
             _S.shift(xi2);
             _S.shift(xi1);
 
             // pre-compute matrix B and A.
-            impulse_response();
+            impulse_response(b1, b2, a1, a2);
+
+            // pre-compute the transition matrix H in block filtering, which carries the gain b_0
+            H(b0, b1, b2, a1, a2);
+
+            // pre-compute the coefficients of the steps in ZIC_NT_RD
+            recursive_doubling_coeffs(a1, a2);
+        };
 
-            // pre-compute the transition matrix H in block filtering
-            H();
+
+        // read the pre-conditions of the particular part, i.e., x_{-1}, x_{-2}.
+        inline void get_inits(T& xi1, T& xi2) {
+            xi1 = _S[-1];
+            xi2 = _S[-2];
+        };
+
+        // overwrite the pre-conditions of the particular part.
+        inline void set_inits(const T xi1, const T xi2) {
+            _S.shift(xi2);
+            _S.shift(xi1);
         };
 
 
@@ -53,14 +90,18 @@ template<typename V> class ZeroInitCond{
             Functions for calculating particular part of second order recursive equation, which are
             ZIC_s: scalar, sample by sample.
             ZIC_NT: block filtering.
+            ZIC_NT_RD: block filtering in log_2(M) steps, the same as ZIC_NT.
+            ZIC_NT_by: one of the two, selected by ZicAlgorithm.
             ZIC_T: multi-block filtering.
+            ZIC_T_inplace: multi-block filtering in place.
+            ZIC_NT_stuffed: block filtering of the zero stuffed input in interpolation.
         
          */
 
         
         // calculate the particular part of recursive equation by scalar
         inline T ZIC_S(const T x) {
-            T w = x + _b1*_S[-1] + _b2*_S[-2];
+            T w = _b0*x + _b1*_S[-1] + _b2*_S[-2];
 
             _S.shift(x);
 
@@ -84,30 +125,139 @@ template<typename V> class ZeroInitCond{
             return w; 
         };
 
-        // calculate the particular part of recursive equation by multi-block filtering
-        inline std::array<V,M> ZIC_T(const std::array<V,M>& x) {
-            std::array<V,M> v, w;
+        /* 
+            calculate the particular part of recursive equation by block filtering in log_2(M) steps.
+            the FIR part u = b_0x + b_1x_{-1} + b_2x_{-2} is formed first, with the pre-conditions shifted in. The all-pole 
+            part 1/(1 - a_1z^{-1} - a_2z^{-2}) truncated to M samples is the product of the factors 1 + c_1z^{-d} - c_2z^{-2d},
+            d=1,2,...,M/2, since each factor turns the denominator 1 - c_1z^{-d} - c_2z^{-2d} into one in z^{-2d}, which is 1 
+            after log_2(M) steps. Each step is two shifts of u within the vector and two FMAs (one in the last step), 
+            i.e., 2log_2(M) + 2 multiplications and FMAs against M + 2 of ZIC_NT and a chain of log_2(M) steps instead of M.
+         */
+        inline V ZIC_NT_RD(const V x) {
+            V x1, x2, u;
+
+            // x1=[x_{-1} x_0 ... x_{M-2}], x2=[x_{-2} x_{-1} ... x_{M-3}]
+            x1 = _shift_inV(x, _S[-1]);
+            x2 = _shift_inV(x1, _S[-2]);
+
+            // the gain b_0 of a unit section (b_0 = 1, e.g., all sections but the first of a design in second order 
+            // sections) takes no multiplication
+            if (_b0 == 1) u = mul_add(x2, _b2, x);
+            else u = mul_add(x2, _b2, x*_b0);
+            u = mul_add(x1, _b1, u);
+
+            // d=1,2,...,M/2, the shift by 2d of the last step is out of the vector
+            _static_for<R>([&](auto k) {
+                constexpr int d = 1 << decltype(k)::value;
+
+                x1 = _shiftV<d>(u);
+
+                if constexpr (2*d < M) {
+                    x2 = _shiftV<2*d>(u);
+                    u = mul_add(x1, _g1[k], u);
+                    u = mul_add(x2, _g2[k], u);
+                } else {
+                    u = mul_add(x1, _g1[k], u);
+                }
+            });
+
+            // vector shift: store the initial conditions for the next block of data.
+            _S.shift(x);
+
+            return u;
+        };
+
+        // block filtering by the algorithm A
+        template<ZicAlgorithm A> inline V ZIC_NT_by(const V x) {
+            if constexpr (A == ZicAlgorithm::rd) return ZIC_NT_RD(x);
+            else return ZIC_NT(x);
+        };
+
+        /* 
+            calculate the particular part of recursive equation by block filtering, for one block of the input upsampled by L,
+            i.e., the low rate samples x[0], x[1], ... sit at the positions ph, ph+L, ... (0 <= ph < L) of the block and the 
+            others are zeros. Only the columns of H at those positions are multiplied, M/L of them instead of M, and the 
+            columns of B only if x_{-1}, x_{-2} are samples (first: the pre-conditions are taken as given, e.g., at the 
+            head of a trunk). The zero stuffed block is never formed.
+         */
+        template<typename InputIt> inline V ZIC_NT_stuffed(InputIt x, const int ph, const int L, const bool first=true) {
+            V w{0};
+            T s1 = 0, s2 = 0;
+
+            if (first || (ph + 2)%L == 0) w = mul_add(_p2, _S[-2], w);
+            if (first || (ph + 1)%L == 0) w = mul_add(_p1, _S[-1], w);
+
+            for (auto c=ph; c<M; c+=L, ++x) {
+                w = mul_add(_H[c], *x, w);
+
+                // the last two positions of the block are the pre-conditions for the next block
+                if (c == M-1) s1 = *x;
+                if (c == M-2) s2 = *x;
+            }
+
+            _S.shift(s2);
+            _S.shift(s1);
+
+            return w;
+        };
+
+        // calculate the particular part of recursive equation by multi-block filtering. len: number of valid samples in X^T (a zero padded matrix if len < M*K).
+        // K: rows of X^T, i.e., the length of the block in each lane, M by default (see ZIC_T_kernel).
+        template<size_t K> inline std::array<V,K> ZIC_T(const std::array<V,K>& x, const int len=M*K) {
+            std::array<V,K> w = x;
+
+            ZIC_T_inplace(w, len);
+
+            return w; 
+        };
+
+        // multi-block filtering on the caller-owned matrix X^T, which is overwritten by W^T without any temporary matrix.
+        template<size_t K> inline void ZIC_T_inplace(std::array<V,K>& x, const int len=M*K) {
+            T x1 = _S[-1], x2 = _S[-2];
+            const bool split = (_a1_lo != 0 || _a2_lo != 0);
+
+            if (!split && _b0 == 1) ZIC_T_kernel<false, true>(x, _b0, _b1, _b2, _a1, _a2, x1, x2, len);
+            else if (!split) ZIC_T_kernel(x, _b0, _b1, _b2, _a1, _a2, x1, x2, len);
+            else if (_b0 == 1) ZIC_T_kernel<true, true>(x, _b0, _b1, _b2, _a1, _a2, x1, x2, len, _a1_lo, _a2_lo);
+            else ZIC_T_kernel<true>(x, _b0, _b1, _b2, _a1, _a2, x1, x2, len, _a1_lo, _a2_lo);
+
+            // 2 times scalar shift: store initial conditions for the next block of data.
+            _S.shift(x2);
+            _S.shift(x1);
+        };
+
+        /* 
+            kernel of ZIC_T on the coefficients and pre-conditions given by reference, shared by the cores and the fused cascade 
+            in fused_series.h. x1, x2: x_{-1}, x_{-2}, updated for the next matrix.
+            K: rows of X^T. Each lane holds a block of K samples, i.e., sample s at X^T_{[s%K]}[s/K]. The recursion runs 
+            down the rows of each lane, thus the rows are not limited to M and a tile of K > M rows amortizes the 
+            transposes and the recursive doubling in icc over more samples.
+            split: the recursion takes a_1 + a1_lo and a_2 + a2_lo, i.e., the coefficients in double as the sum of two values in T,
+            thus the rows see the same poles as the powers of C in icc, which are pre-computed in double. Two more FMAs per row.
+            unit: b_0 = 1, the rows take the samples as they are, i.e., 4 FMAs per row instead of a multiplication and 4 FMAs.
+            The callers select it once per matrix, see ZIC_T_inplace.
+         */
+        template<bool split = false, bool unit = false, size_t K> static inline void ZIC_T_kernel(std::array<V,K>& x, const T b0, const T b1, const T b2, 
+                                                                               const T a1, const T a2, T& x1, T& x2, const int len=M*K,
+                                                                               const T a1_lo=0, const T a2_lo=0) {
 
             // the two blocks contains the initial conditions in particular part
             V xi2, xi1;
             
-            // SSE
-            if constexpr (M == 4) {
-                // get the two initial-condition blocks, xi2=[x_{-2} x_{M-2} x_{2M-2} ...], xi1=[x_{-1} x_{M-1} x_{2M-1} ...]
-                xi2 = blend4<4,0,1,2>(x[M-2], _S[-2]);
-                xi1 = blend4<4,0,1,2>(x[M-1], _S[-1]);
-            }
+            // get the two initial-condition blocks, xi2=[x_{-2} x_{K-2} x_{2K-2} ...], xi1=[x_{-1} x_{K-1} x_{2K-1} ...]
+            xi2 = _shift_inV(x[K-2], x2);
+            xi1 = _shift_inV(x[K-1], x1);
 
-            // AVX2
-            if constexpr (M == 8) {
-                xi2 = blend8<8,0,1,2,3,4,5,6>(x[M-2], _S[-2]);
-                xi1 = blend8<8,0,1,2,3,4,5,6>(x[M-1], _S[-1]);
-            }
+            /* 
+                the initial conditions for the next block of data, which are the last samples in the last two blocks of X^T.
+                sample s sits at X^T_{[s%K]}[s/K], so a partial matrix keeps its last two valid samples instead, and an 
+                empty one keeps the pre-conditions. read before X^T is overwritten.
+             */
+            T s2 = x2, s1 = x1;
 
-            // AVX512
-            if constexpr (M == 16) {
-                xi2 = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(x[M-2], _S[-2]);
-                xi1 = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(x[M-1], _S[-1]);
+            if (len > 0) {
+                s2 = (len > 1) ? x[(len-2)%K][(len-2)/K] : x1;
+                s1 = x[(len-1)%K][(len-1)/K];
             }
 
             /* 
@@ -115,29 +265,40 @@ template<typename V> class ZeroInitCond{
                 interleave the computation by non-dependency part (multiply by b1 and b2) and dependency (a1 and a2)
                 to reduce the waiting time of read-after-write (dependency) issue. Note, this can be automatically done 
                 by using newer version of compiler and faster compiling flags, e.g., -O2, -O3.
+                p2, p1 keep the two previous blocks of X^T, since the blocks are overwritten by W^T.
+                the gain b0 is applied by the first multiplication of each block, no extra pass over the data, and none
+                for a unit section.
              */
-            v[0] = mul_add(xi2, _b2, x[0]);
-            v[0] = mul_add(xi1, _b1, v[0]);
-            w[0] = v[0];
-            v[1] = mul_add(xi1, _b2, x[1]);
-            v[1] = mul_add(x[0], _b1, v[1]);
-            w[1] = mul_add(v[0], _a1, v[1]);
-
-            for (auto n=2; n<M; n++) {
-                v[n] = mul_add(x[n-2], _b2, x[n]);
-                v[n] = mul_add(x[n-1], _b1, v[n]);
-                w[n] = mul_add(w[n-2], _a2, v[n]);
-                w[n] = mul_add(w[n-1], _a1, w[n]);
+            V p2, p1, v;
+
+            p2 = x[0];
+            if constexpr (unit) v = mul_add(xi2, b2, x[0]);
+            else v = mul_add(xi2, b2, x[0]*b0);
+            v = mul_add(xi1, b1, v);
+            x[0] = v;
+            p1 = x[1];
+            if constexpr (unit) v = mul_add(xi1, b2, x[1]);
+            else v = mul_add(xi1, b2, x[1]*b0);
+            v = mul_add(p2, b1, v);
+            if constexpr (split) v = mul_add(x[0], a1_lo, v);
+            x[1] = mul_add(x[0], a1, v);
+
+            for (size_t n=2; n<K; n++) {
+                if constexpr (unit) v = mul_add(p2, b2, x[n]);
+                else v = mul_add(p2, b2, x[n]*b0);
+                v = mul_add(p1, b1, v);
+                p2 = p1;
+                p1 = x[n];
+                if constexpr (split) {
+                    v = mul_add(x[n-2], a2_lo, v);
+                    v = mul_add(x[n-1], a1_lo, v);
+                }
+                x[n] = mul_add(x[n-2], a2, v);
+                x[n] = mul_add(x[n-1], a1, x[n]);
             }
 
-            /* 
-                2 times scalar shift:
-                store initial conditions for the next block of data, which are the last samples in the last two blocks of X^T.
-             */
-            _S.shift(x[M-2][M-1]);
-            _S.shift(x[M-1][M-1]);
-
-            return w; 
+            x2 = s2;
+            x1 = s1;
         };
 
 
@@ -149,63 +310,67 @@ template<typename V> class ZeroInitCond{
 
 
         // calculate matrix B and A for block filtering. The addition of b_1 and a_1 is the lagged impulse response of recursive equation. 
-        inline void impulse_response() {
-            T p2[M+1], p1[M+1], h0[M+1];
+        inline void impulse_response(const double b1, const double b2, const double a1, const double a2) {
+            double p2[M+1], p1[M+1], h0[M+1], h2[M];
 
-            p2[0] = _b2;
-            p2[1] = _a1*_b2;
-            p1[0] = _b1;
-            p1[1] = _a1*_b1 + _b2;
+            p2[0] = b2;
+            p2[1] = a1*b2;
+            p1[0] = b1;
+            p1[1] = a1*b1 + b2;
             h0[0] = 1;
-            h0[1] = _a1;
+            h0[1] = a1;
 
             for (auto n=2; n<M+1; n++){
-                p2[n] = _a1*p2[n-1] + _a2*p2[n-2];
-                p1[n] = _a1*p1[n-1] + _a2*p1[n-2];
-                h0[n] = _a1*h0[n-1] + _a2*h0[n-2];  
+                p2[n] = a1*p2[n-1] + a2*p2[n-2];
+                p1[n] = a1*p1[n-1] + a2*p1[n-2];
+                h0[n] = a1*h0[n-1] + a2*h0[n-2];  
             }
 
-            _p2.load(&p2[0]);
-            _p1.load(&p1[0]);
-            _h2.load(&h0[0]);
-            _h2 *= _a2;
-            _h1.load(&h0[1]);
+            for (auto n=0; n<M; n++) h2[n] = a2*h0[n];
+
+            _p2 = load_rounded<V>(&p2[0]);
+            _p1 = load_rounded<V>(&p1[0]);
+            _h2 = load_rounded<V>(&h2[0]);
+            _h1 = load_rounded<V>(&h0[1]);
+        };
+
+        /* 
+            calculate the coefficients of the steps in ZIC_NT_RD in double: the denominator 1 - c_1z^{-d} - c_2z^{-2d} times 
+            1 + c_1z^{-d} - c_2z^{-2d} is 1 - (c_1^2 + 2c_2)z^{-2d} + c_2^2z^{-4d}, starting from c_1 = a_1, c_2 = a_2 at d=1.
+         */
+        inline void recursive_doubling_coeffs(const double a1, const double a2) {
+            double c1 = a1, c2 = a2;
+
+            for (auto k=0; k<R; k++) {
+                _g1[k] = c1;
+                _g2[k] = -c2;
+
+                const double c1_next = c1*c1 + 2*c2;
+                c2 = -c2*c2;
+                c1 = c1_next;
+            }
         };
 
         // calculate the transition matrix H for block filtering, which is a lower triangular toplitz matrix.
-        inline void H() {
+        inline void H(const double b0, const double b1, const double b2, const double a1, const double a2) {
             V tmp;
-            
-            // SSE
-            if constexpr (M == 4) {
-                // calcualte the first column in H (the exact impulse response), which can be obtained inversely by the addition of h1 and p1. 
-                tmp = blend4<4,0,1,2>(_h1+_p1, 1);
-
-                for (auto n=0; n<M; n++){
-                    _H[n] = tmp;
-                    // the rest columns can be shifted from the first column by 1 position in H 
-                    tmp = permute4<-1,0,1,2>(tmp);
-                }
-            }
 
-            // AVX2
-            if constexpr (M == 8) { 
-                tmp = blend8<8,0,1,2,3,4,5,6>(_h1+_p1, 1);
+            // the first column in H is the exact impulse response: h_0 = b_0, h_1 = a_1b_0 + b_1, h_2 = a_1h_1 + a_2h_0 + b_2, ...
+            double h[M];
 
-                for (auto n=0; n<M; n++){
-                    _H[n] = tmp;
-                    tmp = permute8<-1,0,1,2,3,4,5,6>(tmp);
-                }
+            h[0] = b0;
+            h[1] = a1*b0 + b1;
+
+            for (auto n=2; n<M; n++){
+                h[n] = a1*h[n-1] + a2*h[n-2] + ((n == 2) ? b2 : 0);
             }
 
-            // AVX512
-            if constexpr (M == 16) { 
-                tmp = blend16<16,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(_h1+_p1, 1);
+            tmp = load_rounded<V>(&h[0]);
 
-                for (auto n=0; n<M; n++){
-                    _H[n] = tmp;
-                    tmp = permute16<-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14>(tmp);
-                }
+            // the rest columns can be shifted from the first column by 1 position in H 
+            for (auto n=0; n<M; n++){
+                _H[n] = tmp;
+                tmp = _shiftV<1>(tmp);
             }
         };
         
@@ -0,0 +1,232 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest.h"
+#include "recursive_filter.h"
+#include <cmath>
+#include <numeric>
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+using T = double;
+
+// relative error allowed against the scalar benchmark in double precision
+const T eps = 1e-10;
+
+// three high-Q sections with poles of radius 0.99 and the initial conditions
+T coefs[3][5] = {1, 0.1, -0.5, 2*0.99*std::cos(0.1), -0.99*0.99
+                ,1, -0.4, 0.5, 2*0.99*std::cos(0.7), -0.99*0.99
+                ,1, 0.12, 0.23, 2*0.99*std::cos(2.1), -0.99*0.99
+                }; 
+T inits[3][4] = {2, 3, -0.5, 1.5
+                ,0.5, 0.7, 0.9, 3
+                ,2, 3, 1, 8
+                };
+
+// the second order cores of option 1, 2 and 3 on one matrix
+template<typename V> void option_accuracy() {
+
+    // M: length of SIMD vector.
+    constexpr static int M = V::size();
+
+    std::vector<T> data(M*M);
+    std::iota(data.begin(), data.end(), 0); 
+
+    std::array<V,M> x, y;
+    for (auto n=0; n<M; n++) x[n].load(&data[n*M]);
+
+    std::array<T, M*M> y_ben, y_op1, y_op1_rd, y_op2, y_op3;
+
+    // benchmark (scalar)
+    IirCoreOrderTwo<V> I_ben(coefs[0], inits[0]);
+    for (auto n=0; n<M*M; n++) y_ben[n] = I_ben.benchmark(data[n]);
+
+    // option 1
+    IirCoreOrderTwo<V> I_op1(coefs[0], inits[0]);
+    for (auto n=0; n<M; n++) y[n] = I_op1.option1(x[n]);
+    for (auto n=0; n<M; n++) y[n].store(&y_op1[n*M]); 
+
+    // option 1 in log_2(M) steps
+    IirCoreOrderTwo<V> I_op1_rd(coefs[0], inits[0]);
+    for (auto n=0; n<M; n++) y[n] = I_op1_rd.template option1<ZicAlgorithm::rd>(x[n]);
+    for (auto n=0; n<M; n++) y[n].store(&y_op1_rd[n*M]); 
+
+    // option 2
+    IirCoreOrderTwo<V> I_op2(coefs[0], inits[0]);
+    y = I_op2.option2(x);
+    for (auto n=0; n<M; n++) y[n].store(&y_op2[n*M]); 
+
+    // option 3
+    IirCoreOrderTwo<V> I_op3(coefs[0], inits[0]);
+    y = I_op3.option3(x);
+    for (auto n=0; n<M; n++) y[n].store(&y_op3[n*M]); 
+
+    for (auto n=0; n<M*M; n++) CHECK(y_op1[n] == doctest::Approx(y_ben[n]).epsilon(eps));
+    for (auto n=0; n<M*M; n++) CHECK(y_op1_rd[n] == doctest::Approx(y_ben[n]).epsilon(eps));
+    for (auto n=0; n<M*M; n++) CHECK(y_op2[n] == doctest::Approx(y_ben[n]).epsilon(eps));
+    for (auto n=0; n<M*M; n++) CHECK(y_op3[n] == doctest::Approx(y_ben[n]).epsilon(eps));
+};
+
+// the cascaded filter of every option on a trunk of data that leaves a remainder, split in two calls
+template<typename V> void filter_accuracy() {
+
+    constexpr static int L = 1000, L1 = 333;
+
+    std::vector<T> x(L), y_ben(L), y_op1(L), y_op2(L), y_op3(L), y_op4(L), y_op5(L), y_op6(L);
+    std::iota(x.begin(), x.end(), 0); 
+
+    // benchmark (scalar)
+    IirCoreOrderTwo<V> I_ben1(coefs[0], inits[0]), I_ben2(coefs[1], inits[1]), I_ben3(coefs[2], inits[2]);
+    for (auto n=0; n<L; n++) y_ben[n] = I_ben3.benchmark(I_ben2.benchmark(I_ben1.benchmark(x[n])));
+
+    // filter of scalar
+    Filter<T,3,V> F_op1(coefs,inits);
+    F_op1.cascaded_scalar(x.begin(),x.begin()+L1,y_op1.begin());
+    F_op1.cascaded_scalar(x.begin()+L1,x.end(),y_op1.begin()+L1);
+
+    // filter of option 1
+    Filter<T,3,V> F_op2(coefs,inits);
+    F_op2.cascaded_option1(x.begin(),x.begin()+L1,y_op2.begin());
+    F_op2.cascaded_option1(x.begin()+L1,x.end(),y_op2.begin()+L1);
+
+    // filter of option 2
+    Filter<T,3,V> F_op3(coefs,inits);
+    F_op3.cascaded_option2(x.begin(),x.begin()+L1,y_op3.begin());
+    F_op3.cascaded_option2(x.begin()+L1,x.end(),y_op3.begin()+L1);
+
+    // filter of option 3
+    Filter<T,3,V> F_op4(coefs,inits);
+    F_op4.cascaded_option3(x.begin(),x.begin()+L1,y_op4.begin());
+    F_op4.cascaded_option3(x.begin()+L1,x.end(),y_op4.begin()+L1);
+
+    // filter of operator
+    Filter<T,3,V> F_op5(coefs,inits);
+    F_op5(x.begin(),x.begin()+L1,y_op5.begin());
+    F_op5(x.begin()+L1,x.end(),y_op5.begin()+L1);
+
+    // fused series
+    FusedSeries<V,3> F_op6(coefs,inits);
+    constexpr static int M = V::size();
+    std::array<V,M> t;
+
+    for (auto l=0; l<L; l+=M*M) {
+        const int len = std::min(L - l, M*M);
+
+        for (auto n=0; n<M; n++) t[n].load_partial(std::max(std::min(len - n*M, M), 0), &x[l + n*M]);
+        _permuteV_inplace(t);
+        F_op6.series_option3_inplace(t, len);
+        _permuteV_inplace(t);
+        for (auto n=0; n<M; n++) if (n*M < len) t[n].store_partial(std::min(len - n*M, M), &y_op6[l + n*M]);
+    }
+
+    for (auto n=0; n<L; n++) CHECK(y_op1[n] == doctest::Approx(y_ben[n]).epsilon(eps));
+    for (auto n=0; n<L; n++) CHECK(y_op2[n] == doctest::Approx(y_ben[n]).epsilon(eps));
+    for (auto n=0; n<L; n++) CHECK(y_op3[n] == doctest::Approx(y_ben[n]).epsilon(eps));
+    for (auto n=0; n<L; n++) CHECK(y_op4[n] == doctest::Approx(y_ben[n]).epsilon(eps));
+    for (auto n=0; n<L; n++) CHECK(y_op5[n] == doctest::Approx(y_ben[n]).epsilon(eps));
+    for (auto n=0; n<L; n++) CHECK(y_op6[n] == doctest::Approx(y_ben[n]).epsilon(eps));
+};
+
+// testing for SSE
+TEST_CASE("double accuracy test for M=2:") {
+    option_accuracy<Vec2d>();
+    filter_accuracy<Vec2d>();
+};
+
+// testing for AVX2
+TEST_CASE("double accuracy test for M=4:") {
+    option_accuracy<Vec4d>();
+    filter_accuracy<Vec4d>();
+};
+
+// testing for AVX512
+TEST_CASE("double accuracy test for M=8:") {
+    option_accuracy<Vec8d>();
+    filter_accuracy<Vec8d>();
+};
+
+// testing for filtering on multiple threads with high-Q sections (poles of radius 0.999), split in two calls whose
+// lengths do not divide into the chunks, thus the state carried over the last (longer) chunk decides the second call.
+TEST_CASE("double parallel test:") {
+    constexpr static int L = 100003, L1 = 60001;
+
+    T coefs_q[2][5] = {1, 0.1, -0.5, 2*0.999*std::cos(0.05), -0.999*0.999
+                      ,1, -0.4, 0.5, 2*0.999*std::cos(0.3), -0.999*0.999
+                      };
+    T inits_q[2][4] = {2, 3, -0.5, 1.5
+                      ,0.5, 0.7, 0.9, 3
+                      };
+
+    std::vector<T> x(L), y_ben(L), y_par(L);
+    for (auto n=0; n<L; n++) x[n] = n%17 - 8;
+
+    // benchmark (scalar)
+    IirCoreOrderTwo<Vec4d> I_ben1(coefs_q[0], inits_q[0]), I_ben2(coefs_q[1], inits_q[1]);
+    for (auto n=0; n<L; n++) y_ben[n] = I_ben2.benchmark(I_ben1.benchmark(x[n]));
+
+    // multiple threads, the second call continues from the states of the first one
+    Filter<T,2> F_par(coefs_q, inits_q);
+    F_par.cascaded_parallel(x.begin(), x.begin()+L1, y_par.begin(), 4);
+    F_par.cascaded_parallel(x.begin()+L1, x.end(), y_par.begin()+L1, 3);
+
+    // relative to the peak of the output, the samples near the zero crossings are not compared by their own magnitude
+    const T peak = *std::max_element(y_ben.begin(), y_ben.end(), [](T a, T b) { return std::abs(a) < std::abs(b); });
+
+    for (auto n=0; n<L; n++) CHECK(std::abs(y_par[n] - y_ben[n]) <= 1e-9*std::abs(peak));
+};
+
+// testing for float data filtered by coefficients in double, against the scalar benchmark in double
+TEST_CASE("mixed precision test:") {
+    constexpr static int L = 1000;
+
+    std::vector<float> x(L), y(L);
+    std::vector<T> y_ben(L);
+    std::iota(x.begin(), x.end(), 0); 
+
+    IirCoreOrderTwo<Vec4d> I_ben1(coefs[0], inits[0]), I_ben2(coefs[1], inits[1]), I_ben3(coefs[2], inits[2]);
+    for (auto n=0; n<L; n++) y_ben[n] = I_ben3.benchmark(I_ben2.benchmark(I_ben1.benchmark(x[n])));
+
+    Filter<float,3> F(coefs, inits);
+    F(x.begin(), x.end(), y.begin());
+
+    for (auto n=0; n<L; n++) CHECK(y[n] == doctest::Approx(y_ben[n]).epsilon(1e-3));
+};
+
+// the error of the mixed precision (coefficients in double) against plain float (coefficients rounded to float) for a 
+// section with poles of radius 0.999 and 0.9999, where the rounding of a_1 and a_2 in float moves the poles.
+void mixed_against_float(const T r) {
+    constexpr static int L = 1<<15;
+
+    T coefs_q[1][5] = {1, 0.5, 0.25, 2*r*std::cos(0.3), -r*r};
+    T inits_q[1][4] = {0, 0, 0, 0};
+    float coefs_f[1][5], inits_f[1][4] = {};
+    for (auto k=0; k<5; k++) coefs_f[0][k] = coefs_q[0][k];
+
+    std::vector<float> x(L), y_f(L), y_m(L);
+    std::vector<T> y_ben(L);
+    for (auto n=0; n<L; n++) x[n] = n%17 - 8;
+
+    // benchmark (scalar) in double
+    IirCoreOrderTwo<Vec4d> I_ben(coefs_q[0], inits_q[0]);
+    for (auto n=0; n<L; n++) y_ben[n] = I_ben.benchmark(x[n]);
+
+    Filter<float,1> F_f(coefs_f, inits_f), F_m(coefs_q, inits_q);
+    F_f(x.begin(), x.end(), y_f.begin());
+    F_m(x.begin(), x.end(), y_m.begin());
+
+    T err_f = 0, err_m = 0;
+    for (auto n=0; n<L; n++) {
+        err_f = std::max<T>(err_f, std::abs(y_f[n] - y_ben[n]));
+        err_m = std::max<T>(err_m, std::abs(y_m[n] - y_ben[n]));
+    }
+
+    CHECK(err_m <= err_f);
+};
+
+TEST_CASE("mixed precision against float test:") {
+    mixed_against_float(0.999);
+    mixed_against_float(0.9999);
+};
+
+TEST_SUITE_END();
+
+#endif // doctest
@@ -0,0 +1,138 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest.h"
+#include "recursive_filter.h"
+#include <cmath>
+#include <numeric>
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+using T = float;
+
+// stable sections with poles of radius 0.6 and the initial conditions, read as a configuration of n sections at run time
+void make_config(const int n, std::vector<std::array<T,5>>& coefs, std::vector<std::array<T,4>>& inits) {
+    coefs.resize(n);
+    inits.resize(n);
+
+    for (auto i=0; i<n; i++) {
+        coefs[i] = {1, T(0.5), T(0.25), T(1.2*std::cos(3.14159*(i + 0.5)/n)), T(-0.36)};
+        inits[i] = {T(0.1*i), T(-0.2), T(0.3), T(0.05*i)};
+    }
+};
+
+// testing against the scalar benchmark for several numbers of sections, over two calls with a remainder
+TEST_CASE("dynamic filter accuracy test:") {
+    using V = Vec8f;
+
+    constexpr static int L = 1000, L1 = 333;
+
+    std::vector<T> x(L), y(L), y_ben(L);
+    std::iota(x.begin(), x.end(), 0);
+    for (auto& v: x) v = std::sin(v);
+
+    for (auto n: {1, 3, 7, 13}) {
+        std::vector<std::array<T,5>> coefs;
+        std::vector<std::array<T,4>> inits;
+        make_config(n, coefs, inits);
+
+        auto c = reinterpret_cast<const T (*)[5]>(coefs.data());
+        auto s = reinterpret_cast<const T (*)[4]>(inits.data());
+
+        // benchmark (scalar)
+        std::vector<IirCoreOrderTwo<V>> I_ben;
+        for (auto i=0; i<n; i++) I_ben.emplace_back(c[i], s[i]);
+        for (auto l=0; l<L; l++) {
+            y_ben[l] = x[l];
+            for (auto& I: I_ben) y_ben[l] = I.benchmark(y_ben[l]);
+        }
+
+        DynamicFilter<T,V> F(c, s, n);
+        CHECK(F.sections() == n);
+
+        F(x.begin(), x.begin()+L1, y.begin());
+        F.process(std::span<const T>(x).subspan(L1), std::span<T>(y).subspan(L1));
+
+        // error relative to the peak of the output, the samples near zero are not compared relatively
+        T peak = 0;
+        for (auto l=0; l<L; l++) peak = std::max(peak, std::abs(y_ben[l]));
+
+        for (auto l=0; l<L; l++) CHECK(std::abs(y[l] - y_ben[l]) <= 1e-4*peak);
+
+        // the states left are the ones of the scalar benchmark
+        std::vector<std::array<T,4>> s_ben(n), s_dyn(n);
+        for (auto i=0; i<n; i++) I_ben[i].get_inits(s_ben[i].data());
+        F.get_inits(reinterpret_cast<T (*)[4]>(s_dyn.data()));
+
+        for (auto i=0; i<n; i++) for (auto k=0; k<4; k++) CHECK(std::abs(s_dyn[i][k] - s_ben[i][k]) <= 1e-4*peak);
+    }
+};
+
+// testing for streaming blocks with state snapshot, roll back, hand over and reset, as the state test of Filter
+TEST_CASE("dynamic filter state test:") {
+    constexpr static int n = 5, L = 4096;
+
+    // lengths of the buffers of callbacks
+    const int blocks[] = {32, 64, 500, 128, 1, 512, 255, 33};
+
+    std::vector<std::array<T,5>> coefs;
+    std::vector<std::array<T,4>> inits;
+    make_config(n, coefs, inits);
+
+    auto c = reinterpret_cast<const T (*)[5]>(coefs.data());
+    auto s = reinterpret_cast<const T (*)[4]>(inits.data());
+
+    std::vector<T> x(L), y_ref(L), y(L);
+    for (auto l=0; l<L; l++) x[l] = l%17 - 8;
+
+    DynamicFilter<T> F_ref(c, s, n);
+    F_ref(x.begin(), x.end(), y_ref.begin());
+
+    // blocks of any length, the stream is handed over to another filter in the middle
+    DynamicFilter<T> F(c, s, n), G(c, n);
+    std::span<const T> in(x);
+    std::span<T> out(y);
+    int l = 0;
+
+    for (auto k=0; l<L; k=(k+1)%8) {
+        const int len = std::min(blocks[k], L - l);
+
+        if (l < L/2) F.process(in.subspan(l, len), out.subspan(l, len));
+        else G.process(in.subspan(l, len), out.subspan(l, len));
+
+        l += len;
+
+        if (l >= L/2 && l - len < L/2) G.set_state(F.get_state());
+    }
+
+    // error relative to the peak of the output, the blocks split the trunk into other matrices than the operator
+    T peak = 0;
+    for (auto l=0; l<L; l++) peak = std::max(peak, std::abs(y_ref[l]));
+
+    for (auto l=0; l<L; l++) CHECK(std::abs(y[l] - y_ref[l]) <= 1e-4*peak);
+
+    // the state of the filter handed over is the state of the operator over the whole trunk
+    DynamicFilterState<T> s_ref = F_ref.get_state(), s_G = G.get_state();
+    REQUIRE(s_G.s.size() == n);
+    for (auto i=0; i<n; i++) for (auto k=0; k<4; k++) CHECK(std::abs(s_G.s[i][k] - s_ref.s[i][k]) <= 1e-4*peak);
+
+    // roll back: a block filtered twice from the same snapshot gives the same output
+    std::vector<T> y1(100), y2(100);
+    DynamicFilterState<T> snapshot = F.get_state();
+    F.process(in.first(100), y1);
+    F.set_state(snapshot);
+    F.process(in.first(100), y2);
+
+    for (auto l=0; l<100; l++) CHECK(y1[l] == y2[l]);
+
+    // reset: the same as a filter of zero pre-conditions
+    DynamicFilter<T> F_zero(c, n);
+    F_zero.process(in.first(100), y1);
+    F.reset();
+    F.process(in.first(100), y2);
+
+    for (auto l=0; l<100; l++) CHECK(y1[l] == y2[l]);
+};
+
+TEST_SUITE_END();
+
+#endif // doctest
@@ -2,7 +2,9 @@
 
 #include "doctest.h"
 #include "recursive_filter.h"
+#include <cmath>
 #include <numeric>
+#include <thread>
 
 #ifdef DOCTEST_LIBRARY_INCLUDED
 
@@ -63,6 +65,628 @@ TEST_CASE("filter accuracy test for M=8:") {
 
 };
 
+// testing for the remainder that cannot fill a matrix, and the states carried over two calls
+TEST_CASE("filter remainder test:") {
+    using V = Vec8f;
+
+    // length of data does not divide by M or M*M of any SIMD vector, split in two calls
+    constexpr static int L = 1000, L1 = 333;
+
+    std::vector<T> x(L), y_ben(L), y_op1(L), y_op2(L), y_op3(L), y_op4(L), y_op5(L);
+    std::iota(x.begin(), x.end(), 0); 
+
+    // benchmark (scalar)
+    IirCoreOrderTwo<V> I_ben1(b1,b2,a1,a2,xi1,xi2,yi1,yi2),I_ben2(b1,b2,a1,a2,xi1,xi2,yi1,yi2),I_ben3(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
+    for (auto n=0; n<L; n++) y_ben[n] = I_ben3.benchmark(I_ben2.benchmark(I_ben1.benchmark(x[n])));
+
+    // define array of coefficients and initial conditions
+    T coefs[3][5] = {1,b1,b2,a1,a2,1,b1,b2,a1,a2,1,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    // filter of scalar
+    Filter F_op1(coefs,inits);
+    F_op1.cascaded_scalar(x.begin(),x.begin()+L1,y_op1.begin());
+    F_op1.cascaded_scalar(x.begin()+L1,x.end(),y_op1.begin()+L1);
+
+    // filter of option 1
+    Filter F_op2(coefs,inits);
+    F_op2.cascaded_option1(x.begin(),x.begin()+L1,y_op2.begin());
+    F_op2.cascaded_option1(x.begin()+L1,x.end(),y_op2.begin()+L1);
+
+    // filter of option 2
+    Filter F_op3(coefs,inits);
+    F_op3.cascaded_option2(x.begin(),x.begin()+L1,y_op3.begin());
+    F_op3.cascaded_option2(x.begin()+L1,x.end(),y_op3.begin()+L1);
+
+    // filter of option 3
+    Filter F_op4(coefs,inits);
+    F_op4.cascaded_option3(x.begin(),x.begin()+L1,y_op4.begin());
+    F_op4.cascaded_option3(x.begin()+L1,x.end(),y_op4.begin()+L1);
+
+    // filter of operator
+    Filter F_op5(coefs,inits);
+    auto d_last = F_op5(x.begin(),x.begin()+L1,y_op5.begin());
+    CHECK(d_last == y_op5.begin()+L1);
+    F_op5(x.begin()+L1,x.end(),y_op5.begin()+L1);
+
+    // filter in place
+    Filter F_op6(coefs,inits);
+    std::vector<T> y_op6 = x;
+    F_op6.filter_inplace(std::span<T>(y_op6).first(L1));
+    F_op6.filter_inplace(std::span<T>(y_op6).subspan(L1));
+
+    // check accuracy of filter sample by sample
+    for (auto n=0; n<L; n++) CHECK(y_op1[n] == doctest::Approx(y_ben[n]));
+    for (auto n=0; n<L; n++) CHECK(y_op2[n] == doctest::Approx(y_ben[n]));
+    for (auto n=0; n<L; n++) CHECK(y_op3[n] == doctest::Approx(y_ben[n]));
+    for (auto n=0; n<L; n++) CHECK(y_op4[n] == doctest::Approx(y_ben[n]));
+    for (auto n=0; n<L; n++) CHECK(y_op5[n] == doctest::Approx(y_ben[n]));
+    for (auto n=0; n<L; n++) CHECK(y_op6[n] == doctest::Approx(y_ben[n]));
+
+};
+
+// testing for filtering on multiple threads, compared with the single thread operator over two calls
+TEST_CASE("filter parallel test:") {
+
+    // length of data does not divide by the number of threads or M*M
+    constexpr static int L = 100003, L1 = 60001;
+
+    std::vector<T> x(L), y_ref(L), y_par(L);
+    for (auto n=0; n<L; n++) x[n] = n%17 - 8;
+
+    T coefs[3][5] = {1,b1,b2,a1,a2,1,b1,b2,a1,a2,1,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    // single thread
+    Filter F_ref(coefs,inits);
+    F_ref(x.begin(),x.end(),y_ref.begin());
+
+    // multiple threads, the second call continues from the states of the first one
+    Filter F_par(coefs,inits);
+    auto d_last = F_par.cascaded_parallel(x.begin(),x.begin()+L1,y_par.begin(),4);
+    CHECK(d_last == y_par.begin()+L1);
+    F_par.cascaded_parallel(x.begin()+L1,x.end(),y_par.begin()+L1,3);
+
+    for (auto n=0; n<L; n++) CHECK(y_par[n] == doctest::Approx(y_ref[n]).epsilon(1e-4));
+
+};
+
+// testing for streaming blocks of audio callbacks with state snapshot, roll back, hand over and reset
+TEST_CASE("filter state test:") {
+    static_assert(std::is_trivially_copyable_v<FilterState<T,3>>);
+
+    constexpr static int L = 4096;
+
+    // lengths of the buffers of callbacks
+    const int blocks[] = {32, 64, 500, 128, 1, 512, 255, 33};
+
+    std::vector<T> x(L), y_ref(L), y(L);
+    for (auto n=0; n<L; n++) x[n] = n%17 - 8;
+
+    T coefs[3][5] = {1,b1,b2,a1,a2,1,b1,b2,a1,a2,1,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    Filter F_ref(coefs,inits);
+    F_ref(x.begin(),x.end(),y_ref.begin());
+
+    // blocks of any length, the stream is handed over to another filter in the middle
+    Filter F(coefs,inits), G(coefs,inits);
+    std::span<const T> in(x);
+    std::span<T> out(y);
+    int l = 0;
+
+    for (auto k=0; l<L; k=(k+1)%8) {
+        const int len = std::min(blocks[k], L - l);
+
+        if (l < L/2) F.process(in.subspan(l, len), out.subspan(l, len));
+        else G.process(in.subspan(l, len), out.subspan(l, len));
+
+        l += len;
+
+        if (l >= L/2 && l - len < L/2) G.set_state(F.get_state());
+    }
+
+    for (auto n=0; n<L; n++) CHECK(y[n] == doctest::Approx(y_ref[n]));
+
+    // roll back: a block filtered twice from the same snapshot gives the same output
+    std::vector<T> y1(100), y2(100);
+    FilterState<T,3> snapshot = F.get_state();
+    F.process(in.first(100), y1);
+    F.set_state(snapshot);
+    F.process(in.first(100), y2);
+
+    for (auto n=0; n<100; n++) CHECK(y1[n] == y2[n]);
+
+    // reset: the same as a filter of zero pre-conditions
+    T zeros[3][4] = {0};
+    Filter F_zero(coefs,zeros);
+    F_zero.process(in.first(100), y1);
+    F.reset();
+    F.process(in.first(100), y2);
+
+    for (auto n=0; n<100; n++) CHECK(y1[n] == y2[n]);
+
+};
+
+// testing for the gain b0 of each section, against the recurrence y_n = b_0x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
+TEST_CASE("filter gain test:") {
+
+    constexpr static int L = 1000, L1 = 333;
+
+    T coefs[3][5] = {0.5,b1,b2,a1,a2,-2,b1,b2,a1,a2,0.25,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    std::vector<T> x(L), y_ref(L), y_op1(L), y_op2(L), y_op3(L), y_op4(L), y_op5(L), y_par(L);
+    for (auto n=0; n<L; n++) x[n] = n%17 - 8;
+
+    // the recurrence section by section
+    y_ref = x;
+    for (auto i=0; i<3; i++) {
+        T x1 = inits[i][0], x2 = inits[i][1], y1 = inits[i][2], y2 = inits[i][3];
+
+        for (auto& v: y_ref) {
+            T y = coefs[i][0]*v + coefs[i][1]*x1 + coefs[i][2]*x2 + coefs[i][3]*y1 + coefs[i][4]*y2;
+
+            x2 = x1; x1 = v;
+            y2 = y1; y1 = y;
+            v = y;
+        }
+    }
+
+    Filter F_op1(coefs,inits), F_op2(coefs,inits), F_op3(coefs,inits), F_op4(coefs,inits), F_op5(coefs,inits), F_par(coefs,inits);
+
+    F_op1.cascaded_scalar(x.begin(),x.begin()+L1,y_op1.begin());
+    F_op1.cascaded_scalar(x.begin()+L1,x.end(),y_op1.begin()+L1);
+    F_op2.cascaded_option1(x.begin(),x.begin()+L1,y_op2.begin());
+    F_op2.cascaded_option1(x.begin()+L1,x.end(),y_op2.begin()+L1);
+    F_op3.cascaded_option2(x.begin(),x.begin()+L1,y_op3.begin());
+    F_op3.cascaded_option2(x.begin()+L1,x.end(),y_op3.begin()+L1);
+    F_op4.cascaded_option3(x.begin(),x.begin()+L1,y_op4.begin());
+    F_op4.cascaded_option3(x.begin()+L1,x.end(),y_op4.begin()+L1);
+    F_op5(x.begin(),x.begin()+L1,y_op5.begin());
+    F_op5(x.begin()+L1,x.end(),y_op5.begin()+L1);
+    F_par.cascaded_parallel(x.begin(),x.end(),y_par.begin(),3);
+
+    for (auto n=0; n<L; n++) CHECK(y_op1[n] == doctest::Approx(y_ref[n]));
+    for (auto n=0; n<L; n++) CHECK(y_op2[n] == doctest::Approx(y_ref[n]));
+    for (auto n=0; n<L; n++) CHECK(y_op3[n] == doctest::Approx(y_ref[n]));
+    for (auto n=0; n<L; n++) CHECK(y_op4[n] == doctest::Approx(y_ref[n]));
+    for (auto n=0; n<L; n++) CHECK(y_op5[n] == doctest::Approx(y_ref[n]));
+    for (auto n=0; n<L; n++) CHECK(y_par[n] == doctest::Approx(y_ref[n]).epsilon(1e-4));
+
+};
+
+// testing for zero-phase forward-backward filtering against the reference of padding, filtering, reversing and filtering again
+TEST_CASE("filtfilt test:") {
+
+    constexpr static int L = 1000, P = 3*(2*3+1);
+
+    T coefs[3][5] = {0.5,b1,b2,a1,a2,-2,b1,b2,a1,a2,0.25,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    std::vector<T> x(L), y(L);
+    for (auto n=0; n<L; n++) x[n] = std::sin(0.05*n) + (n%7 - 3)*0.1;
+
+    // the cascaded recurrence in double from the steady state of the first sample
+    auto sosfilt = [&](std::vector<double> v) {
+        double c = v[0];
+
+        for (auto i=0; i<3; i++) {
+            double g = (coefs[i][0] + coefs[i][1] + coefs[i][2])/(1 - coefs[i][3] - coefs[i][4]);
+            double x1 = c, x2 = c, y1 = c*g, y2 = c*g;
+
+            for (auto& u: v) {
+                double w = coefs[i][0]*u + coefs[i][1]*x1 + coefs[i][2]*x2 + coefs[i][3]*y1 + coefs[i][4]*y2;
+
+                x2 = x1; x1 = u;
+                y2 = y1; y1 = w;
+                u = w;
+            }
+
+            c *= g;
+        }
+
+        return v;
+    };
+
+    for (auto padtype: {PadType::odd, PadType::even, PadType::none}) {
+        const int p = (padtype == PadType::none) ? 0 : P;
+
+        // reference: extension, forward, reverse, backward, reverse
+        std::vector<double> ext(L + 2*p);
+        for (auto n=0; n<L; n++) ext[p + n] = x[n];
+        for (auto n=0; n<p; n++) {
+            ext[n] = (padtype == PadType::odd) ? 2*x[0] - x[p - n] : x[p - n];
+            ext[p + L + n] = (padtype == PadType::odd) ? 2*x[L-1] - x[L - 2 - n] : x[L - 2 - n];
+        }
+
+        ext = sosfilt(ext);
+        std::reverse(ext.begin(), ext.end());
+        ext = sosfilt(ext);
+        std::reverse(ext.begin(), ext.end());
+
+        Filter F(coefs,inits);
+        auto d_last = F.filtfilt(x.begin(), x.end(), y.begin(), padtype);
+        CHECK(d_last == y.end());
+
+        for (auto n=0; n<L; n++) CHECK(y[n] == doctest::Approx(ext[p + n]).epsilon(1e-4));
+
+        // the pre-conditions are kept
+        T s[3][4];
+        F.get_inits(s);
+        for (auto i=0; i<3; i++) for (auto k=0; k<4; k++) CHECK(s[i][k] == inits[i][k]);
+    }
+
+    // a constant input stays constant with the squared DC gain of the filter
+    std::vector<T> c(L, 1), y_c(L);
+    Filter F(coefs,inits);
+    F.filtfilt(c.begin(), c.end(), y_c.begin());
+
+    double G = 1;
+    for (auto i=0; i<3; i++) G *= (coefs[i][0] + coefs[i][1] + coefs[i][2])/(1 - coefs[i][3] - coefs[i][4]);
+
+    for (auto n=0; n<L; n++) CHECK(y_c[n] == doctest::Approx(G*G).epsilon(1e-4));
+
+};
+
+// testing for the decimating filter against every D-th output of the operator, over chunks of any length
+TEST_CASE("decimation test:") {
+
+    constexpr static int L = 1000, L1 = 333, L2 = 517;
+
+    T coefs[3][5] = {0.5,b1,b2,a1,a2,-2,b1,b2,a1,a2,0.25,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    std::vector<T> x(L), y_ref(L);
+    for (auto n=0; n<L; n++) x[n] = n%17 - 8;
+
+    Filter F_ref(coefs,inits);
+    F_ref(x.begin(), x.end(), y_ref.begin());
+
+    for (auto D: {1, 2, 3, 4, 5, 8, 12, 16, 64, 100, 300}) {
+        std::vector<T> y(L);
+
+        Filter F(coefs,inits);
+        auto d_last = F.decimate(x.begin(), x.begin()+L1, y.begin(), D);
+        d_last = F.decimate(x.begin()+L1, x.begin()+L2, d_last, D);
+        d_last = F.decimate(x.begin()+L2, x.end(), d_last, D);
+
+        CHECK(d_last - y.begin() == (L + D - 1)/D);
+
+        for (auto k=0; k<(L + D - 1)/D; k++) CHECK(y[k] == doctest::Approx(y_ref[k*D]));
+
+        // the state is carried over exactly
+        T s[3][4], s_ref[3][4];
+        F.get_inits(s);
+        F_ref.get_inits(s_ref);
+        for (auto i=0; i<3; i++) for (auto k=0; k<4; k++) CHECK(s[i][k] == doctest::Approx(s_ref[i][k]));
+    }
+
+};
+
+// testing for the interpolating filter against the operator on the zero stuffed input, over chunks of any length
+TEST_CASE("interpolation test:") {
+
+    constexpr static int L = 150, L1 = 37, L2 = 91;
+
+    T coefs[3][5] = {0.5,b1,b2,a1,a2,-2,b1,b2,a1,a2,0.25,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    std::vector<T> x(L);
+    for (auto n=0; n<L; n++) x[n] = n%17 - 8;
+
+    for (auto U: {1, 2, 3, 4, 5, 8, 16, 20, 33}) {
+        std::vector<T> x_up(L*U, 0), y_ref(L*U), y(L*U);
+        for (auto n=0; n<L; n++) x_up[n*U] = x[n];
+
+        Filter F_ref(coefs,inits), F(coefs,inits);
+        F_ref(x_up.begin(), x_up.end(), y_ref.begin());
+
+        auto d_last = F.interpolate(x.begin(), x.begin()+L1, y.begin(), U);
+        d_last = F.interpolate(x.begin()+L1, x.begin()+L2, d_last, U);
+        d_last = F.interpolate(x.begin()+L2, x.end(), d_last, U);
+
+        CHECK(d_last == y.end());
+
+        for (auto n=0; n<L*U; n++) CHECK(y[n] == doctest::Approx(y_ref[n]));
+
+        // the state is carried over exactly
+        T s[3][4], s_ref[3][4];
+        F.get_inits(s);
+        F_ref.get_inits(s_ref);
+        for (auto i=0; i<3; i++) for (auto k=0; k<4; k++) CHECK(s[i][k] == doctest::Approx(s_ref[i][k]));
+    }
+
+};
+
+// testing for the operator on data in the tile order against the operator, converted by transpose_tiles
+TEST_CASE("transposed layout test:") {
+    using V = simd_vector_t<T>;
+
+    // M: length of SIMD vector.
+    constexpr static int M = V::size();
+
+    // chunks of whole matrices, then a remainder
+    constexpr static int L1 = 3*M*M, L = 5*M*M + 7;
+
+    T coefs[3][5] = {0.5,b1,b2,a1,a2,-2,b1,b2,a1,a2,0.25,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    std::vector<T> x(L), x_T(L), y_T(L), y(L), y_ref(L);
+    for (auto n=0; n<L; n++) x[n] = n%17 - 8;
+
+    Filter F_ref(coefs,inits), F(coefs,inits);
+    F_ref(x.begin(), x.end(), y_ref.begin());
+
+    // the sample s of a matrix is at (s%M)*M + s/M
+    transpose_tiles<V>(x.begin(), x.end(), x_T.begin());
+    CHECK(x_T[M*M + 1] == x[M*M + M]);
+    CHECK(x_T[M*M + M] == x[M*M + 1]);
+
+    F.transposed(x_T.begin(), x_T.begin()+L1, y_T.begin());
+    auto d_last = F.transposed(x_T.begin()+L1, x_T.end(), y_T.begin()+L1);
+    CHECK(d_last == y_T.end());
+
+    auto y_last = transpose_tiles<V>(y_T.begin(), y_T.end(), y.begin());
+    CHECK(y_last == y.end());
+
+    for (auto n=0; n<L; n++) CHECK(y[n] == doctest::Approx(y_ref[n]));
+
+    // in place
+    F.set_inits(inits);
+    F.transposed(x_T.begin(), x_T.end(), x_T.begin());
+    for (auto n=0; n<L; n++) CHECK(x_T[n] == y_T[n]);
+
+};
+
+// testing for the streaming mode on aligned buffers against the operator, and the fallback of unaligned buffers
+TEST_CASE("streaming test:") {
+    using V = simd_vector_t<T>;
+
+    // M: length of SIMD vector.
+    constexpr static int M = V::size();
+
+    constexpr static int L = 40*M*M + 5, L1 = 17*M*M;
+
+    T coefs[3][5] = {0.5,b1,b2,a1,a2,-2,b1,b2,a1,a2,0.25,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    aligned_vector<T> x(L + 1), y(L + 1);
+    huge_page_vector<T> y_h(L);
+    std::vector<T> y_ref(L);
+
+    CHECK(reinterpret_cast<uintptr_t>(x.data())%64 == 0);
+    CHECK(reinterpret_cast<uintptr_t>(y_h.data())%(2 << 20) == 0);
+
+    for (auto n=0; n<L+1; n++) x[n] = n%17 - 8;
+
+    Filter F_ref(coefs,inits), F(coefs,inits), F_h(coefs,inits), F_u(coefs,inits);
+    F_ref(x.begin(), x.begin()+L, y_ref.begin());
+
+    F.streaming(x.data(), x.data()+L1, y.data());
+    T* d_last = F.streaming(x.data()+L1, x.data()+L, y.data()+L1);
+    CHECK(d_last == y.data()+L);
+
+    F_h.streaming(x.data(), x.data()+L, y_h.data(), 2);
+
+    for (auto n=0; n<L; n++) CHECK(y[n] == y_ref[n]);
+    for (auto n=0; n<L; n++) CHECK(y_h[n] == y_ref[n]);
+
+    // unaligned output: the operator
+    F_u.streaming(x.data(), x.data()+L, y.data()+1);
+    for (auto n=0; n<L; n++) CHECK(y[n+1] == y_ref[n]);
+
+};
+
+// testing for the output-less reductions against the statistics of the output of the operator
+TEST_CASE("reduction test:") {
+    using V = simd_vector_t<T>;
+
+    constexpr static int L = 1000, L1 = 333;
+
+    T coefs[3][5] = {0.5,b1,b2,a1,a2,-2,b1,b2,a1,a2,0.25,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    std::vector<T> x(L), y(L);
+    for (auto n=0; n<L; n++) x[n] = std::sin(0.05*n) + (n%7 - 3)*0.1;
+
+    Filter F_ref(coefs,inits), F(coefs,inits);
+    F_ref(x.begin(), x.end(), y.begin());
+
+    double sum = 0, energy = 0;
+    T lo = y[0], hi = y[0];
+    for (auto v: y) {
+        sum += v;
+        energy += double(v)*v;
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+    }
+
+    // the statistics and a user functor counting the samples over two trunks
+    Statistics<V> stats;
+    long count = 0;
+    auto counter = [&](const std::array<V,V::size()>&, int len) { count += len; };
+
+    F.reduce(x.begin(), x.begin()+L1, stats);
+    F.reduce(x.begin(), x.begin()+L1, counter);
+    F.set_inits(inits);
+    F.reduce(x.begin(), x.begin()+L1, stats);
+    FilterState<T,3> state = F.reduce(x.begin()+L1, x.end(), stats);
+
+    CHECK(stats.count() == L + L1);
+    CHECK(count == L1);
+
+    // the first trunk is reduced twice
+    for (auto n=0; n<L1; n++) {
+        sum += y[n];
+        energy += double(y[n])*y[n];
+    }
+
+    CHECK(stats.sum() == doctest::Approx(sum).epsilon(1e-4));
+    CHECK(stats.energy() == doctest::Approx(energy).epsilon(1e-4));
+    CHECK(stats.mean() == doctest::Approx(sum/(L + L1)).epsilon(1e-4));
+    CHECK(stats.rms() == doctest::Approx(std::sqrt(energy/(L + L1))).epsilon(1e-4));
+    CHECK(stats.min() == doctest::Approx(lo));
+    CHECK(stats.max() == doctest::Approx(hi));
+    CHECK(stats.peak() == doctest::Approx(std::max(-lo, hi)));
+
+    // the final state is the state of the operator
+    T s_ref[3][4];
+    F_ref.get_inits(s_ref);
+    for (auto i=0; i<3; i++) for (auto k=0; k<4; k++) CHECK(state.s[i][k] == doctest::Approx(s_ref[i][k]));
+
+};
+
+TEST_CASE("icc tables test:") {
+    using V = simd_vector_t<T>;
+
+    constexpr static int L = 1000;
+
+    T coefs[3][5] = {0.5,b1,b2,a1,a2,-2,b1,b2,a1,a2,0.25,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    std::vector<T> x(L), y_rd(L), y_lazy(L), y_mm(L), y_lazy_mm(L), y_rd2(L), y_lazy_rd2(L);
+    for (auto n=0; n<L; n++) x[n] = std::sin(0.05*n) + (n%7 - 3)*0.1;
+
+    // the policy only changes which tables are kept, the operator is the same
+    Filter<T,3,V,IccTables::rd> F_rd(coefs,inits);
+    Filter<T,3,V> F_lazy(coefs,inits);
+
+    F_rd(x.begin(), x.end(), y_rd.begin());
+    F_lazy(x.begin(), x.end(), y_lazy.begin());
+
+    for (auto n=0; n<L; n++) CHECK(y_lazy[n] == y_rd[n]);
+
+    // the tables built on the first use are those built by the constructor
+    Filter<T,3,V,IccTables::mm> F_mm(coefs,inits);
+    Filter<T,3,V,IccTables::rd2> F_rd2(coefs,inits);
+    Filter<T,3,V> F_lazy_mm(coefs,inits), F_lazy_rd2(coefs,inits);
+
+    F_mm.cascaded_tile<IccAlgorithm::mm>(x.begin(), x.end(), y_mm.begin());
+    F_lazy_mm.cascaded_tile<IccAlgorithm::mm>(x.begin(), x.end(), y_lazy_mm.begin());
+    F_rd2.cascaded_tile<IccAlgorithm::rd2>(x.begin(), x.end(), y_rd2.begin());
+    F_lazy_rd2.cascaded_tile<IccAlgorithm::rd2>(x.begin(), x.end(), y_lazy_rd2.begin());
+
+    for (auto n=0; n<L; n++) {
+        CHECK(y_lazy_mm[n] == y_mm[n]);
+        CHECK(y_lazy_rd2[n] == y_rd2[n]);
+        CHECK(y_mm[n] == doctest::Approx(y_rd[n]).epsilon(1e-3));
+        CHECK(y_rd2[n] == doctest::Approx(y_rd[n]).epsilon(1e-3));
+    }
+
+    // the copies made before the first use share the tables, built once by whichever thread calls first
+    Filter<T,3,V> F_lazy_src(coefs,inits);
+    std::vector<Filter<T,3,V>> copies(4, F_lazy_src);
+    std::vector<std::vector<T>> y_copies(4, std::vector<T>(L));
+    std::vector<std::thread> threads;
+
+    for (auto i=0; i<4; i++) threads.emplace_back([&, i]() {
+        if (i%2) copies[i].template cascaded_tile<IccAlgorithm::mm>(x.begin(), x.end(), y_copies[i].begin());
+        else copies[i].template cascaded_tile<IccAlgorithm::rd2>(x.begin(), x.end(), y_copies[i].begin());
+    });
+    for (auto& t: threads) t.join();
+
+    for (auto n=0; n<L; n++) {
+        CHECK(y_copies[1][n] == y_mm[n]);
+        CHECK(y_copies[3][n] == y_mm[n]);
+        CHECK(y_copies[0][n] == y_rd2[n]);
+        CHECK(y_copies[2][n] == y_rd2[n]);
+    }
+
+    // footprint of the sections
+    CHECK(sizeof(IirCoreOrderTwo<V,IccTables::rd>) < sizeof(IirCoreOrderTwo<V,IccTables::rd2>));
+    CHECK(sizeof(IirCoreOrderTwo<V,IccTables::rd2>) < sizeof(IirCoreOrderTwo<V,IccTables::mm>));
+    CHECK(sizeof(IirCoreOrderTwo<V>) < sizeof(IirCoreOrderTwo<V,IccTables::mm>));
+
+};
+
+// testing for the tiles of M blocks of K samples, against the M by M tiles
+TEST_CASE("rectangular tile test:") {
+    using V = simd_vector_t<T>;
+
+    constexpr static int M = V::size();
+
+    // a remainder for each tile
+    constexpr static int L = 5*M*M*4 + 3*M + 5;
+
+    T coefs[3][5] = {0.5,b1,b2,a1,a2,-2,b1,b2,a1,a2,0.25,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    std::vector<T> x(L), y_ref(L), y2(L), y4(L), y_split(L);
+    for (auto n=0; n<L; n++) x[n] = std::sin(0.05*n) + (n%7 - 3)*0.1;
+
+    Filter<T,3,V> F_ref(coefs,inits);
+    Filter<T,3,V,IccTables::lazy,2*M> F2(coefs,inits);
+    Filter<T,3,V,IccTables::lazy,4*M> F4(coefs,inits), F_split(coefs,inits);
+
+    F_ref(x.begin(), x.end(), y_ref.begin());
+    F2(x.begin(), x.end(), y2.begin());
+    F4(x.begin(), x.end(), y4.begin());
+
+    // the state is carried between calls across the tiles and the remainder
+    F_split(x.begin(), x.begin() + L/3, y_split.begin());
+    F_split(x.begin() + L/3, x.end(), y_split.begin() + L/3);
+
+    for (auto n=0; n<L; n++) {
+        CHECK(y2[n] == doctest::Approx(y_ref[n]).epsilon(1e-4));
+        CHECK(y4[n] == doctest::Approx(y_ref[n]).epsilon(1e-4));
+        CHECK(y_split[n] == doctest::Approx(y_ref[n]).epsilon(1e-4));
+    }
+
+    FilterState<T,3> s_ref = F_ref.get_state(), s4 = F4.get_state();
+
+    for (auto i=0; i<3; i++) for (auto k=0; k<4; k++) CHECK(s4.s[i][k] == doctest::Approx(s_ref.s[i][k]).epsilon(1e-4));
+
+};
+
+// testing for the wavefront across the sections, against the operator
+TEST_CASE("wavefront test:") {
+    using V = simd_vector_t<T>;
+
+    constexpr static int M = V::size();
+
+    // a remainder, and fewer tiles than sections in the second call
+    constexpr static int L = 20*M*M + 3*M + 5, L1 = L - 3*M*M - 7;
+
+    T coefs[6][5], inits[6][4];
+    for (auto i=0; i<6; i++) {
+        T c[5] = {T(0.5 + 0.25*i), b1, b2, a1, a2}, s[4] = {xi1, xi2, yi1, yi2};
+        std::copy(c, c + 5, coefs[i]);
+        std::copy(s, s + 4, inits[i]);
+    }
+
+    std::vector<T> x(L), y_ref(L), y(L), y_in(L);
+    for (auto n=0; n<L; n++) x[n] = std::sin(0.05*n) + (n%7 - 3)*0.1;
+
+    Filter<T,6,V> F_ref(coefs,inits), F(coefs,inits), F_in(coefs,inits);
+    Filter<T,6,V,IccTables::lazy,2*M> F2_ref(coefs,inits), F2(coefs,inits);
+
+    F_ref(x.begin(), x.end(), y_ref.begin());
+    F.cascaded_wavefront(x.begin(), x.begin() + L1, y.begin());
+    F.cascaded_wavefront(x.begin() + L1, x.end(), y.begin() + L1);
+
+    // in place
+    y_in = x;
+    F_in.cascaded_wavefront(y_in.begin(), y_in.end(), y_in.begin());
+
+    // the same tiles as the operator in one call, the tiles are split at another place in two calls
+    for (auto n=0; n<L; n++) {
+        CHECK(y[n] == doctest::Approx(y_ref[n]));
+        CHECK(y_in[n] == y_ref[n]);
+    }
+
+    FilterState<T,6> s_ref = F_ref.get_state(), s = F.get_state();
+
+    for (auto i=0; i<6; i++) for (auto k=0; k<4; k++) CHECK(s.s[i][k] == doctest::Approx(s_ref.s[i][k]));
+
+    // the tiles of 2M rows
+    F2_ref(x.begin(), x.end(), y_ref.begin());
+    F2.cascaded_wavefront(x.begin(), x.end(), y.begin());
+
+    for (auto n=0; n<L; n++) CHECK(y[n] == y_ref[n]);
+
+};
+
 TEST_SUITE_END();
 
 #endif // doctest
@@ -0,0 +1,68 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest.h"
+#include "recursive_filter.h"
+#include <numeric>
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+using T = float;
+
+// second order filter coefficients and initial conditions
+T b1 = 0.1, b2 = -0.5, a1 = 0.2, a2 = 0.3, xi1 = 2, xi2 = 3, yi1 = -0.5, yi2 = 1.5;
+
+// number of channels (not a multiple of the vector length) and samples per channel
+constexpr static int C = 20, L = 101;
+
+// testing for interleaved channels
+TEST_CASE("multi-channel accuracy test for interleaved layout:") {
+    using V = Vec8f;
+
+    // channel c is a ramp starting from c
+    std::vector<T> x(C*L), y(C*L), y_ben(C*L);
+    for (auto n=0; n<L; n++) for (auto c=0; c<C; c++) x[n*C+c] = n + c;
+
+    // benchmark (scalar), channel by channel
+    for (auto c=0; c<C; c++) {
+        IirCoreOrderTwo<V> I_ben1(b1,b2,a1,a2,xi1,xi2,yi1,yi2),I_ben2(b1,b2,a1,a2,xi1,xi2,yi1,yi2),I_ben3(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
+        for (auto n=0; n<L; n++) y_ben[n*C+c] = I_ben3.benchmark(I_ben2.benchmark(I_ben1.benchmark(x[n*C+c])));
+    }
+
+    // define array of coefficients and initial conditions
+    T coefs[3][5] = {1,b1,b2,a1,a2,1,b1,b2,a1,a2,1,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    MultiChannelFilter<T,3,C> F(coefs,inits);
+    auto r = F.interleaved(x.begin(),x.end(),y.begin());
+
+    CHECK(r == y.end());
+    for (auto n=0; n<C*L; n++) CHECK(y[n] == doctest::Approx(y_ben[n]));
+
+};
+
+// testing for planar channels
+TEST_CASE("multi-channel accuracy test for planar layout:") {
+    using V = Vec8f;
+
+    std::vector<T> x(C*L), y(C*L), y_ben(C*L);
+    for (auto c=0; c<C; c++) for (auto n=0; n<L; n++) x[c*L+n] = n + c;
+
+    for (auto c=0; c<C; c++) {
+        IirCoreOrderTwo<V> I_ben1(b1,b2,a1,a2,xi1,xi2,yi1,yi2),I_ben2(b1,b2,a1,a2,xi1,xi2,yi1,yi2),I_ben3(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
+        for (auto n=0; n<L; n++) y_ben[c*L+n] = I_ben3.benchmark(I_ben2.benchmark(I_ben1.benchmark(x[c*L+n])));
+    }
+
+    T coefs[3][5] = {1,b1,b2,a1,a2,1,b1,b2,a1,a2,1,b1,b2,a1,a2}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+    MultiChannelFilter<T,3,C> F(coefs,inits);
+    auto r = F.planar(x.begin(),x.end(),y.begin());
+
+    CHECK(r == y.end());
+    for (auto n=0; n<C*L; n++) CHECK(y[n] == doctest::Approx(y_ben[n]));
+
+};
+
+TEST_SUITE_END();
+
+#endif // doctest
@@ -25,7 +25,7 @@ TEST_CASE("option accuracy test for M=4:") {
     std::array<V,M> x, y;
     for (auto n=0; n<M; n++) x[n].load(&data[n*M]);
 
-    std::array<T, M*M> y_ben, y_op1, y_op2, y_op3;
+    std::array<T, M*M> y_ben, y_op1, y_op1_rd, y_op2, y_op3;
 
     // benchmark (scalar)
     IirCoreOrderTwo<V> I_ben(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
@@ -36,6 +36,11 @@ TEST_CASE("option accuracy test for M=4:") {
     for (auto n=0; n<M; n++) y[n] = I_op1.option1(x[n]);
     for (auto n=0; n<M; n++) y[n].store(&y_op1[n*M]); 
 
+    // option 1 in log_2(M) steps
+    IirCoreOrderTwo<V> I_op1_rd(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
+    for (auto n=0; n<M; n++) y[n] = I_op1_rd.option1<ZicAlgorithm::rd>(x[n]);
+    for (auto n=0; n<M; n++) y[n].store(&y_op1_rd[n*M]); 
+
     // Option 2
     IirCoreOrderTwo<V> I_op2(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
     y = I_op2.option2(x);
@@ -48,6 +53,7 @@ TEST_CASE("option accuracy test for M=4:") {
 
     // check accuracy of filter sample by sample
     for (auto n=0; n<M*M; n++) CHECK(y_op1[n] == doctest::Approx(y_ben[n]));
+    for (auto n=0; n<M*M; n++) CHECK(y_op1_rd[n] == doctest::Approx(y_ben[n]));
     for (auto n=0; n<M*M; n++) CHECK(y_op2[n] == doctest::Approx(y_ben[n]));
     for (auto n=0; n<M*M; n++) CHECK(y_op3[n] == doctest::Approx(y_ben[n]));
 
@@ -67,7 +73,7 @@ TEST_CASE("option accuracy test for M=8:") {
     std::array<V,M> x, y;
     for (auto n=0; n<M; n++) x[n].load(&data[n*M]);
 
-    std::array<T, M*M> y_ben, y_op1, y_op2, y_op3;
+    std::array<T, M*M> y_ben, y_op1, y_op1_rd, y_op2, y_op3;
 
     // benchmark (scalar)
     IirCoreOrderTwo<V> I_ben(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
@@ -78,6 +84,11 @@ TEST_CASE("option accuracy test for M=8:") {
     for (auto n=0; n<M; n++) y[n] = I_op1.option1(x[n]);
     for (auto n=0; n<M; n++) y[n].store(&y_op1[n*M]); 
 
+    // option 1 in log_2(M) steps
+    IirCoreOrderTwo<V> I_op1_rd(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
+    for (auto n=0; n<M; n++) y[n] = I_op1_rd.option1<ZicAlgorithm::rd>(x[n]);
+    for (auto n=0; n<M; n++) y[n].store(&y_op1_rd[n*M]); 
+
     // Option 2
     IirCoreOrderTwo<V> I_op2(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
     y = I_op2.option2(x);
@@ -90,6 +101,7 @@ TEST_CASE("option accuracy test for M=8:") {
 
     // check accuracy of filter sample by sample
     for (auto n=0; n<M*M; n++) CHECK(y_op1[n] == doctest::Approx(y_ben[n]));
+    for (auto n=0; n<M*M; n++) CHECK(y_op1_rd[n] == doctest::Approx(y_ben[n]));
     for (auto n=0; n<M*M; n++) CHECK(y_op2[n] == doctest::Approx(y_ben[n]));
     for (auto n=0; n<M*M; n++) CHECK(y_op3[n] == doctest::Approx(y_ben[n]));
 
@@ -109,7 +121,7 @@ TEST_CASE("option accuracy test for M=16:") {
     std::array<V,M> x, y;
     for (auto n=0; n<M; n++) x[n].load(&data[n*M]);
 
-    std::array<T, M*M> y_ben, y_op1, y_op2, y_op3;
+    std::array<T, M*M> y_ben, y_op1, y_op1_rd, y_op2, y_op3;
 
     // benchmark (scalar)
     IirCoreOrderTwo<V> I_ben(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
@@ -120,6 +132,11 @@ TEST_CASE("option accuracy test for M=16:") {
     for (auto n=0; n<M; n++) y[n] = I_op1.option1(x[n]);
     for (auto n=0; n<M; n++) y[n].store(&y_op1[n*M]); 
 
+    // option 1 in log_2(M) steps
+    IirCoreOrderTwo<V> I_op1_rd(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
+    for (auto n=0; n<M; n++) y[n] = I_op1_rd.option1<ZicAlgorithm::rd>(x[n]);
+    for (auto n=0; n<M; n++) y[n].store(&y_op1_rd[n*M]); 
+
     // Option 2
     IirCoreOrderTwo<V> I_op2(b1,b2,a1,a2,xi1,xi2,yi1,yi2);
     y = I_op2.option2(x);
@@ -132,6 +149,7 @@ TEST_CASE("option accuracy test for M=16:") {
 
     // check accuracy of filter sample by sample
     for (auto n=0; n<M*M; n++) CHECK(y_op1[n] == doctest::Approx(y_ben[n]));
+    for (auto n=0; n<M*M; n++) CHECK(y_op1_rd[n] == doctest::Approx(y_ben[n]));
     for (auto n=0; n<M*M; n++) CHECK(y_op2[n] == doctest::Approx(y_ben[n]));
     for (auto n=0; n<M*M; n++) CHECK(y_op3[n] == doctest::Approx(y_ben[n]));
 
@@ -0,0 +1,120 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest.h"
+#include "recursive_filter.h"
+#include <cstdio>
+#include <fstream>
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+using T = float;
+
+// second order filter coefficients and initial conditions
+T b1 = 0.1, b2 = -0.5, a1 = 0.2, a2 = 0.3, xi1 = 2, xi2 = 3, yi1 = -0.5, yi2 = 1.5;
+
+T coefs[3][5] = {0.5,b1,b2,a1,a2,-2,b1,b2,a1,a2,0.25,b1,b2,a1,a2}; 
+T inits[3][4] = {xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2,xi1,xi2,yi1,yi2};
+
+// every candidate the planner can bind gives the output and the state of the operator
+TEST_CASE("planner candidates test:") {
+
+    constexpr static int L = 1000, L1 = 333;
+
+    std::vector<T> x(L), y_ref(L);
+    for (auto n=0; n<L; n++) x[n] = n%17 - 8;
+
+    Filter F(coefs,inits);
+    F(x.begin(), x.end(), y_ref.begin());
+
+    T s_ref[3][4];
+    F.get_inits(s_ref);
+
+    for (auto& p: Planner<T,3>::candidates()) {
+        std::vector<T> y(L);
+
+        auto K = Planner<T,3>::make(p, coefs, inits);
+        (*K)(x.data(), x.data() + L1, y.data());
+        (*K)(x.data() + L1, x.data() + L, y.data() + L1);
+
+        for (auto n=0; n<L; n++) CHECK(y[n] == doctest::Approx(y_ref[n]));
+
+        T s[3][4];
+        K->get_inits(s);
+        for (auto i=0; i<3; i++) for (auto k=0; k<4; k++) CHECK(s[i][k] == doctest::Approx(s_ref[i][k]));
+    }
+
+};
+
+// the plan is measured once, saved to the wisdom file and loaded by the next run
+TEST_CASE("planner wisdom test:") {
+
+    const char* path = "planner_test.wisdom";
+    std::remove(path);
+
+    Plan p;
+    {
+        Wisdom wisdom(path);
+        CHECK(wisdom.size() == 0);
+
+        PlannedFilter<T,3> F(coefs, inits, 1000, wisdom);
+        p = F.plan();
+
+        CHECK(wisdom.size() == 1);
+        CHECK(wisdom.find(Planner<T,3>::key(1024)) != nullptr);
+    }
+
+    Wisdom wisdom(path);
+    const Plan* q = wisdom.find(Planner<T,3>::key(1000));
+
+    REQUIRE(q != nullptr);
+    CHECK(q->width == p.width);
+    CHECK(q->strategy == p.strategy);
+    CHECK(q->icc == p.icc);
+    CHECK(q->rows == p.rows);
+
+    // the filter of the loaded plan is not measured again, and filters as Filter
+    PlannedFilter<T,3> F(coefs, inits, 1000, wisdom);
+    CHECK(wisdom.size() == 1);
+
+    std::vector<T> x(1000), y(1000), y_ref(1000);
+    for (auto n=0; n<1000; n++) x[n] = n%17 - 8;
+
+    Filter F_ref(coefs,inits);
+    F_ref(x.begin(), x.end(), y_ref.begin());
+    F(x.data(), x.data() + 1000, y.data());
+
+    for (auto n=0; n<1000; n++) CHECK(y[n] == doctest::Approx(y_ref[n]));
+
+    std::remove(path);
+};
+
+// the lines of unknown strategies or algorithms of icc, or of another format, are rejected rather than merged
+TEST_CASE("planner wisdom format test:") {
+
+    const char* path = "planner_format_test.wisdom";
+    {
+        std::ofstream os(path);
+        os << "float/instrset:8/N:3/len:1024 8 tile icc_t 16 0.5\n";
+        os << "float/instrset:8/N:3/len:2048 8 tile icc_t_xx 8 0.5\n";
+        os << "float/instrset:8/N:3/len:4096 8 option9 icc_t 8 0.5\n";
+        os << "float/instrset:8/N:3/len:8192 8 tile icc_t 0.5\n";
+        os << "float/instrset:8/N:3/len:16384 8 tile icc_t 8 0.5 1\n";
+    }
+
+    Wisdom wisdom(path);
+    CHECK(wisdom.size() == 1);
+
+    const Plan* q = wisdom.find("float/instrset:8/N:3/len:1024");
+
+    REQUIRE(q != nullptr);
+    CHECK(q->width == 8);
+    CHECK(q->strategy == Strategy::tile);
+    CHECK(q->icc == IccAlgorithm::rd);
+    CHECK(q->rows == 16);
+
+    std::remove(path);
+};
+
+TEST_SUITE_END();
+
+#endif // doctest
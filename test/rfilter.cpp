@@ -0,0 +1,132 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest.h"
+#include "recursive_filter.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// the rfilter executable, given by CMake
+#ifndef RFILTER_PATH
+#define RFILTER_PATH "./rfilter"
+#endif
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+// three sections in the convention of this library, b0 b1 b2 a1 a2
+double sos[3][5] = {0.5, 0.1, -0.5, 2*0.95*std::cos(0.1), -0.95*0.95
+                   ,1, -0.4, 0.5, 2*0.95*std::cos(0.7), -0.95*0.95
+                   ,1, 0.12, 0.23, 2*0.95*std::cos(2.1), -0.95*0.95
+                   };
+
+inline void write_sos(const char* path) {
+    std::ofstream os(path);
+
+    os << "# b0 b1 b2 a1 a2\n";
+    os.precision(17);
+    for (auto i=0; i<3; i++) os << sos[i][0] << " " << sos[i][1] << " " << sos[i][2] << " " << sos[i][3] << " " << sos[i][4] << "\n";
+};
+
+inline std::vector<char> read_file(const char* path) {
+    std::ifstream is(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+};
+
+inline int rfilter(const std::string& args) {
+    return std::system((std::string(RFILTER_PATH) + " " + args).c_str());
+};
+
+// the interleaved channels against the operator of Filter on each channel, with zero pre-conditions
+template<typename T> void check_channels(const T* y, const T* x, const long frames, const int C, const double eps) {
+    T coeffs[3][5], inits[3][4] = {};
+    for (auto i=0; i<3; i++) for (auto k=0; k<5; k++) coeffs[i][k] = sos[i][k];
+
+    for (auto c=0; c<C; c++) {
+        std::vector<T> x_c(frames), y_c(frames);
+
+        for (long n=0; n<frames; n++) x_c[n] = x[n*C + c];
+
+        Filter<T,3> F(coeffs, inits);
+        F(x_c.begin(), x_c.end(), y_c.begin());
+
+        for (long n=0; n<frames; n++) CHECK(y[n*C + c] == doctest::Approx(y_c[n]).epsilon(eps));
+    }
+};
+
+// a WAV of 32 bit float in chunks that do not divide the frames, on fewer threads than channels
+TEST_CASE("rfilter wav round trip test:") {
+    constexpr static int C = 3;
+    constexpr static long frames = 10007;
+
+    const char *sos_path = "rfilter_test.sos", *in_path = "rfilter_test_in.wav", *out_path = "rfilter_test_out.wav";
+    write_sos(sos_path);
+
+    std::vector<float> x(frames*C);
+    for (long n=0; n<frames; n++) for (auto c=0; c<C; c++) x[n*C + c] = float((n*(c + 1))%17 - 8)/8;
+
+    // RIFF header, fmt chunk of IEEE float (tag 3), data chunk
+    auto u16 = [](std::ofstream& os, uint16_t v) { os.write(reinterpret_cast<const char*>(&v), 2); };
+    auto u32 = [](std::ofstream& os, uint32_t v) { os.write(reinterpret_cast<const char*>(&v), 4); };
+    const uint32_t bytes = x.size()*sizeof(float);
+    {
+        std::ofstream os(in_path, std::ios::binary);
+        os.write("RIFF", 4); u32(os, 36 + bytes); os.write("WAVE", 4);
+        os.write("fmt ", 4); u32(os, 16); u16(os, 3); u16(os, C); u32(os, 48000); u32(os, 48000*C*4); u16(os, C*4); u16(os, 32);
+        os.write("data", 4); u32(os, bytes);
+        os.write(reinterpret_cast<const char*>(x.data()), bytes);
+    }
+
+    REQUIRE(rfilter(std::string("--chunk 1000 --threads 2 ") + sos_path + " " + in_path + " " + out_path) == 0);
+
+    std::vector<char> in = read_file(in_path), out = read_file(out_path);
+    REQUIRE(out.size() == in.size());
+
+    // the header is copied, the samples are filtered
+    CHECK(std::memcmp(out.data(), in.data(), 44) == 0);
+
+    std::vector<float> y(frames*C);
+    std::memcpy(y.data(), out.data() + 44, bytes);
+    check_channels(y.data(), x.data(), frames, C, 1e-4);
+
+    std::remove(sos_path);
+    std::remove(in_path);
+    std::remove(out_path);
+};
+
+// a raw file of 64 bit float on more threads than channels
+TEST_CASE("rfilter raw round trip test:") {
+    constexpr static int C = 2;
+    constexpr static long frames = 5003;
+
+    const char *sos_path = "rfilter_test.sos", *in_path = "rfilter_test_in.f64", *out_path = "rfilter_test_out.f64";
+    write_sos(sos_path);
+
+    std::vector<double> x(frames*C);
+    for (long n=0; n<frames; n++) for (auto c=0; c<C; c++) x[n*C + c] = double((n*(c + 3))%13 - 6)/6;
+    {
+        std::ofstream os(in_path, std::ios::binary);
+        os.write(reinterpret_cast<const char*>(x.data()), x.size()*sizeof(double));
+    }
+
+    REQUIRE(rfilter(std::string("--format f64 --channels 2 --chunk 777 --threads 3 ") + sos_path + " " + in_path + " " + out_path) == 0);
+
+    std::vector<char> out = read_file(out_path);
+    REQUIRE(out.size() == x.size()*sizeof(double));
+
+    std::vector<double> y(frames*C);
+    std::memcpy(y.data(), out.data(), out.size());
+    check_channels(y.data(), x.data(), frames, C, 1e-10);
+
+    std::remove(sos_path);
+    std::remove(in_path);
+    std::remove(out_path);
+};
+
+TEST_SUITE_END();
+
+#endif // doctest
@@ -182,6 +182,57 @@ TEST_CASE("series accuracy test for M=16:") {
 
 };
 
+// fused cascade on several matrices and a partial one against the cores of scalar
+template<typename V> void fused_accuracy() {
+
+    // M: length of SIMD vector.
+    constexpr static int M = V::size();
+
+    // 3 full matrices and a partial one
+    constexpr static int L = 3*M*M + M + 3;
+
+    T coefs[3][5] = {0.5,b1,b2,a1,a2,1,-0.4,0.5,0.5,0.1,1,0.12,0.23,0.31,0.8}; 
+    T inits[3][4] = {xi1,xi2,yi1,yi2,0.5,0.7,0.9,3,2,3,1,8};
+
+    std::vector<T> data(L), y_ben(L), y_fus(L);
+    std::iota(data.begin(), data.end(), 0); 
+
+    // benchmark (scalar)
+    IirCoreOrderTwo<V> I_ben1(coefs[0], inits[0]), I_ben2(coefs[1], inits[1]), I_ben3(coefs[2], inits[2]);
+    for (auto n=0; n<L; n++) y_ben[n] = I_ben3.benchmark(I_ben2.benchmark(I_ben1.benchmark(data[n])));
+
+    // fused series, matrix by matrix
+    FusedSeries<V,3> F(coefs, inits);
+    std::array<V,M> x;
+
+    for (auto l=0; l<L; l+=M*M) {
+        const int len = std::min(L - l, M*M);
+
+        for (auto n=0; n<M; n++) x[n].load_partial(std::max(std::min(len - n*M, M), 0), &data[l + n*M]);
+        _permuteV_inplace(x);
+        F.series_option3_inplace(x, len);
+        _permuteV_inplace(x);
+        for (auto n=0; n<M; n++) if (n*M < len) x[n].store_partial(std::min(len - n*M, M), &y_fus[l + n*M]);
+    }
+
+    for (auto n=0; n<L; n++) CHECK(y_fus[n] == doctest::Approx(y_ben[n]));
+
+    // the pre-conditions left by the fused series are the ones left by the cores
+    T s_ben[3][4], s_fus[3][4];
+    I_ben1.get_inits(s_ben[0]);
+    I_ben2.get_inits(s_ben[1]);
+    I_ben3.get_inits(s_ben[2]);
+    F.get_inits(s_fus);
+
+    for (auto i=0; i<3; i++) for (auto k=0; k<4; k++) CHECK(s_fus[i][k] == doctest::Approx(s_ben[i][k]));
+};
+
+TEST_CASE("fused series accuracy test:") {
+    fused_accuracy<Vec4f>();
+    fused_accuracy<Vec8f>();
+    fused_accuracy<Vec16f>();
+};
+
 TEST_SUITE_END();
 
 #endif // doctest
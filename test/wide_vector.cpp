@@ -0,0 +1,119 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest.h"
+#include "recursive_filter.h"
+#include <cmath>
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+// second order filter coefficients and initial conditions
+double b1 = 0.1, b2 = -0.5, a1 = 0.2, a2 = 0.3, xi1 = 2, xi2 = 3, yi1 = -0.5, yi2 = 1.5;
+
+// the patterns split into the native registers, against the lanes of the pattern
+template<typename W> void lane_patterns() {
+    using T = decltype(std::declval<W>().extract(0));
+    constexpr int M = W::size();
+
+    T a[M], b[M];
+    for (auto n=0; n<M; n++) {
+        a[n] = n + 1;
+        b[n] = -(n + 1);
+    }
+
+    W x, y;
+    x.load(a);
+    y.load(b);
+
+    auto check = [&]<typename P>(P) {
+        W p = _permute_as<P>(x), q = _blend_as<P>(x, y);
+
+        for (auto n=0; n<M; n++) {
+            const int s = P::at(n);
+
+            if (s < M) CHECK(p[n] == (s < 0 ? 0 : a[s]));
+            CHECK(q[n] == (s < 0 ? 0 : (s < M ? a[s] : b[s-M])));
+        }
+    };
+
+    check(_ShiftUp<M,1>{});
+    check(_ShiftUp<M,M/2>{});
+    check(_ShiftIn<M>{});
+    check(_ShiftOut<M>{});
+    check(_Spread<M,1>{});
+    check(_Spread<M,M/2>{});
+    check(_Repeat<M,M/4>{});
+    check(_First<M>{});
+    check(_Reverse<M>{});
+
+    // transpose by the native blocks
+    std::array<W,M> t;
+    T row[M];
+
+    for (auto r=0; r<M; r++) {
+        for (auto c=0; c<M; c++) row[c] = r*M + c;
+        t[r].load(row);
+    }
+
+    _permuteV_inplace(t);
+
+    for (auto r=0; r<M; r++) for (auto c=0; c<M; c++) CHECK(t[r][c] == c*M + r);
+};
+
+// filtering on the logical vector, against the native vector
+template<typename W> void filter_accuracy() {
+    using T = decltype(std::declval<W>().extract(0));
+    constexpr int M = W::size();
+
+    // a remainder of a partial matrix
+    const int L = 7*M*M + 3*M + 1;
+
+    T coefs[3][5] = {0.5,T(b1),T(b2),T(a1),T(a2),-2,T(b1),T(b2),T(a1),T(a2),0.25,T(b1),T(b2),T(a1),T(a2)};
+    T inits[3][4] = {T(xi1),T(xi2),T(yi1),T(yi2),T(xi1),T(xi2),T(yi1),T(yi2),T(xi1),T(xi2),T(yi1),T(yi2)};
+
+    std::vector<T> x(L), y_ref(L), y(L), y1(L), y1_rd(L), y2(L);
+    for (auto n=0; n<L; n++) x[n] = std::sin(0.05*n) + (n%7 - 3)*0.1;
+
+    Filter<T,3,simd_vector_t<T>> F_ref(coefs,inits);
+    Filter<T,3,W> F(coefs,inits), F1(coefs,inits), F1_rd(coefs,inits), F2(coefs,inits);
+
+    F_ref(x.begin(), x.end(), y_ref.begin());
+    F(x.begin(), x.end(), y.begin());
+    F1.cascaded_option1(x.begin(), x.end(), y1.begin());
+    F1_rd.template cascaded_option1<ZicAlgorithm::rd>(x.begin(), x.end(), y1_rd.begin());
+    F2.cascaded_option2(x.begin(), x.end(), y2.begin());
+
+    for (auto n=0; n<L; n++) {
+        CHECK(y[n] == doctest::Approx(y_ref[n]).epsilon(1e-4));
+        CHECK(y1[n] == doctest::Approx(y_ref[n]).epsilon(1e-4));
+        CHECK(y1_rd[n] == doctest::Approx(y_ref[n]).epsilon(1e-4));
+        CHECK(y2[n] == doctest::Approx(y_ref[n]).epsilon(1e-4));
+    }
+
+    // the state carried to the next call
+    FilterState<T,3> s_ref = F_ref.get_state(), s = F.get_state();
+
+    for (auto i=0; i<3; i++) for (auto k=0; k<4; k++) CHECK(s.s[i][k] == doctest::Approx(s_ref.s[i][k]).epsilon(1e-4));
+};
+
+// testing for 8 and 16 lanes on SSE
+TEST_CASE("wide vector test for SSE:") {
+    lane_patterns<WideVec<Vec4f,2>>();
+    lane_patterns<WideVec<Vec4f,4>>();
+    lane_patterns<WideVec<Vec2d,4>>();
+    filter_accuracy<WideVec<Vec4f,2>>();
+    filter_accuracy<WideVec<Vec4f,4>>();
+    filter_accuracy<WideVec<Vec2d,2>>();
+};
+
+// testing for 16 and 32 lanes on AVX2
+TEST_CASE("wide vector test for AVX2:") {
+    lane_patterns<WideVec<Vec8f,2>>();
+    lane_patterns<WideVec<Vec4d,4>>();
+    filter_accuracy<WideVec<Vec8f,2>>();
+    filter_accuracy<WideVec<Vec8f,4>>();
+    filter_accuracy<WideVec<Vec4d,4>>();
+};
+
+TEST_SUITE_END();
+
+#endif // doctest
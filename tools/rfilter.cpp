@@ -0,0 +1,350 @@
+#include "recursive_filter.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+
+    rfilter: filter a raw or WAV file of any size by cascaded second order sections.
+
+        rfilter [options] <sos file> <input> <output>
+
+        --format f32|f64|s16   sample format of a raw input, f32 by default (a WAV input carries its own)
+        --channels C           number of interleaved channels of a raw input, 1 by default
+        --threads K            worker threads, the hardware concurrency by default
+        --chunk F              frames per chunk, 1048576 by default, i.e., F samples of scratch per channel
+
+    The sos file holds one section per line (blank lines and lines starting with # are skipped), either
+        b0 b1 b2 a1 a2         the recursion of this library: y_n = b_0x_n + b_1x_{n-1} + b_2x_{n-2} + a_1y_{n-1} + a_2y_{n-2}
+        b0 b1 b2 a0 a1 a2      the sos of scipy.signal and MATLAB: a_0y_n = b_0x_n + ... - a_1y_{n-1} - a_2y_{n-2}
+
+    The input and output are memory mapped, thus files larger than RAM are streamed chunk by chunk: the chunk k+1 is
+    read ahead on a background thread while the workers filter the channels of the chunk k, and the pages of the chunk
+    k are released after it is written. Each chunk is read once, frame by frame, into planar channels (the workers 
+    split the frames), the channels are filtered in place (the workers split the channels), then written back frame 
+    by frame. The output has the format (and the header of a WAV) of the input. Samples of f32 and s16 are filtered 
+    in float, f64 in double. The state of each channel is carried over between the chunks.
+
+ */
+
+
+// sample formats of the files
+enum class Format { f32, f64, s16 };
+
+struct Options {
+    Format format = Format::f32;
+    int channels = 1;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    long chunk = 1 << 20;
+};
+
+// a read only or read and write memory map of a whole file
+struct MappedFile {
+    int fd = -1;
+    char* data = nullptr;
+    size_t size = 0;
+
+    ~MappedFile() {
+        if (data) munmap(data, size);
+        if (fd >= 0) close(fd);
+    };
+};
+
+[[noreturn]] inline void fail(const std::string& msg) {
+    std::fprintf(stderr, "rfilter: %s\n", msg.c_str());
+    std::exit(1);
+};
+
+// read the sections, each row b0, b1, b2, a1, a2 in the convention of this library
+inline std::vector<double> read_sos(const char* path) {
+    std::ifstream is(path);
+    std::string line;
+    std::vector<double> sos;
+
+    if (!is) fail(std::string("cannot read the sos file ") + path);
+
+    while (std::getline(is, line)) {
+        std::istringstream ss(line);
+        std::vector<double> v;
+        double c;
+
+        if (line.find_first_not_of(" \t\r") == std::string::npos || line[line.find_first_not_of(" \t\r")] == '#') continue;
+
+        while (ss >> c) v.push_back(c);
+
+        if (v.size() == 5) {
+            sos.insert(sos.end(), v.begin(), v.end());
+        } else if (v.size() == 6 && v[3] != 0) {
+            // normalize by a0 and flip the signs of the feedback coefficients
+            sos.insert(sos.end(), {v[0]/v[3], v[1]/v[3], v[2]/v[3], -v[4]/v[3], -v[5]/v[3]});
+        } else {
+            fail("a section of the sos file needs 5 (b0 b1 b2 a1 a2) or 6 (b0 b1 b2 a0 a1 a2) coefficients: " + line);
+        }
+    }
+
+    if (sos.empty()) fail(std::string("no section in ") + path);
+
+    return sos;
+};
+
+// the data chunk of a WAV file, returns false if the file is not a WAV
+inline bool parse_wav(const char* p, const size_t size, Options& opt, size_t& offset, size_t& bytes) {
+    auto u16 = [&](size_t i) { uint16_t v; std::memcpy(&v, p + i, 2); return v; };
+    auto u32 = [&](size_t i) { uint32_t v; std::memcpy(&v, p + i, 4); return v; };
+
+    if (size < 12 || std::memcmp(p, "RIFF", 4) || std::memcmp(p + 8, "WAVE", 4)) return false;
+
+    int tag = 0, bits = 0;
+    bool fmt = false;
+
+    for (size_t i=12; i + 8 <= size; ) {
+        size_t len = u32(i + 4);
+
+        if (!std::memcmp(p + i, "fmt ", 4) && len >= 16) {
+            tag = u16(i + 8);
+            opt.channels = u16(i + 10);
+            bits = u16(i + 22);
+
+            // WAVE_FORMAT_EXTENSIBLE: the format is the first two bytes of the sub format
+            if (tag == 0xFFFE && len >= 26) tag = u16(i + 32);
+            fmt = true;
+        }
+
+        if (!std::memcmp(p + i, "data", 4)) {
+            if (!fmt) fail("the fmt chunk of the WAV is missing");
+
+            if (tag == 1 && bits == 16) opt.format = Format::s16;
+            else if (tag == 3 && bits == 32) opt.format = Format::f32;
+            else if (tag == 3 && bits == 64) opt.format = Format::f64;
+            else fail("the WAV must be 16 bit PCM, 32 or 64 bit float");
+
+            offset = i + 8;
+            bytes = std::min(len, size - offset);
+
+            return true;
+        }
+
+        // chunks are padded to an even size
+        i += 8 + len + (len & 1);
+    }
+
+    fail("the data chunk of the WAV is missing");
+};
+
+// conversions between the samples in the file and the filter
+template<typename T, typename S> inline T load_sample(const char* p) {
+    S s;
+    std::memcpy(&s, p, sizeof(S));
+
+    if constexpr (std::is_same_v<S, int16_t>) return T(s)*T(1.0/32768);
+    else return T(s);
+};
+
+template<typename T, typename S> inline void store_sample(char* p, const T v) {
+    S s;
+
+    if constexpr (std::is_same_v<S, int16_t>) s = S(std::lrint(std::min(std::max(v*T(32768), T(-32768)), T(32767))));
+    else s = S(v);
+
+    std::memcpy(p, &s, sizeof(S));
+};
+
+// the whole pages inside [first, last) of a memory map, as madvise and msync take page aligned ranges only
+inline std::pair<char*, size_t> pages(const char* first, const char* last) {
+    const uintptr_t page = sysconf(_SC_PAGESIZE);
+    uintptr_t f = (uintptr_t(first) + page - 1)/page*page, l = uintptr_t(last)/page*page;
+
+    return {reinterpret_cast<char*>(f), (l > f) ? l - f : 0};
+};
+
+// the frames [f0, f1) of the interleaved samples into planar channels, channel c from planar + c*stride
+template<typename T, typename S> inline void deinterleave(const char* in, const long f0, const long f1, const int C, T* planar, const long stride) {
+    const size_t frame = C*sizeof(S);
+
+    for (long i=f0; i<f1; i++) {
+        for (auto c=0; c<C; c++) planar[c*stride + i] = load_sample<T,S>(in + i*frame + c*sizeof(S));
+    }
+};
+
+// the frames [f0, f1) of the planar channels back into the interleaved samples
+template<typename T, typename S> inline void interleave(const T* planar, const long stride, const long f0, const long f1, const int C, char* out) {
+    const size_t frame = C*sizeof(S);
+
+    for (long i=f0; i<f1; i++) {
+        for (auto c=0; c<C; c++) store_sample<T,S>(out + i*frame + c*sizeof(S), planar[c*stride + i]);
+    }
+};
+
+// run f(w) on the workers w = 0, 1, ..., W-1 and wait for all of them
+template<typename F> inline void parallel(const int W, F&& f) {
+    std::vector<std::thread> pool;
+
+    for (auto w=0; w<W; w++) pool.emplace_back(f, w);
+    for (auto& p: pool) p.join();
+};
+
+// filter the interleaved frames of in into out chunk by chunk, T: data type of the filter, S: data type of the samples.
+template<typename T, typename S> void run(const Options& opt, const std::vector<double>& sos, const char* in, char* out, const long frames) {
+    const int C = opt.channels, W = opt.threads, n = sos.size()/5;
+    const size_t frame = C*sizeof(S);
+
+    // one filter per channel of the same sections
+    std::vector<T> coeffs(sos.begin(), sos.end());
+    std::vector<DynamicFilter<T>> filters(C, DynamicFilter<T>(reinterpret_cast<const T (*)[5]>(coeffs.data()), n));
+
+    // the planar channels of a chunk, channel c from c*chunk
+    std::vector<T> planar(C*opt.chunk);
+
+    // read ahead: touch every page of a chunk of the input
+    auto read_ahead = [&](const long f0) {
+        const long f1 = std::min(f0 + opt.chunk, frames);
+        const size_t page = sysconf(_SC_PAGESIZE);
+        [[maybe_unused]] volatile char sink;
+        char sum = 0;
+
+        if (f0 >= f1) return;
+
+        auto [p, size] = pages(in + f0*frame, in + f1*frame);
+        if (size) madvise(p, size, MADV_WILLNEED);
+
+        for (size_t i=f0*frame; i<f1*frame; i+=page) sum += in[i];
+        sink = sum;
+    };
+
+    read_ahead(0);
+
+    for (long f0=0; f0<frames; f0+=opt.chunk) {
+        const long len = std::min(opt.chunk, frames - f0);
+
+        // the frames of worker w, [w*len/W, (w+1)*len/W) of the chunk
+        auto first = [&](const int w) { return w*len/W; };
+
+        std::thread reader(read_ahead, f0 + opt.chunk);
+
+        // deinterleave: each worker reads its frames of the chunk once
+        parallel(W, [&](const int w) {
+            deinterleave<T,S>(in + f0*frame, first(w), first(w + 1), C, planar.data(), opt.chunk);
+        });
+
+        // filter: worker w filters the channels w, w+W, ... in place
+        parallel(std::min(W, C), [&](const int w) {
+            for (auto c=w; c<C; c+=W) {
+                T* x = planar.data() + c*opt.chunk;
+
+                filters[c](x, x + len, x);
+            }
+        });
+
+        // interleave: each worker writes its frames of the chunk once
+        parallel(W, [&](const int w) {
+            interleave<T,S>(planar.data(), opt.chunk, first(w), first(w + 1), C, out + f0*frame);
+        });
+
+        reader.join();
+
+        // the chunk is done: drop the input pages, and start writing the output pages back
+        auto [p_in, size_in] = pages(in + f0*frame, in + (f0 + len)*frame);
+        auto [p_out, size_out] = pages(out + f0*frame, out + (f0 + len)*frame);
+
+        if (size_in) madvise(p_in, size_in, MADV_DONTNEED);
+        if (size_out) msync(p_out, size_out, MS_ASYNC);
+    }
+};
+
+int main(int argc, char** argv) {
+    Options opt;
+    std::vector<const char*> paths;
+
+    for (auto i=1; i<argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--format" && i + 1 < argc) {
+            std::string f = argv[++i];
+
+            if (f == "f32") opt.format = Format::f32;
+            else if (f == "f64") opt.format = Format::f64;
+            else if (f == "s16") opt.format = Format::s16;
+            else fail("unknown format " + f);
+        }
+        else if (arg == "--channels" && i + 1 < argc) opt.channels = std::atoi(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) opt.threads = std::atoi(argv[++i]);
+        else if (arg == "--chunk" && i + 1 < argc) opt.chunk = std::atol(argv[++i]);
+        else if (arg.rfind("--", 0) == 0) fail("unknown option " + arg);
+        else paths.push_back(argv[i]);
+    }
+
+    if (paths.size() != 3) {
+        std::fprintf(stderr, "usage: rfilter [--format f32|f64|s16] [--channels C] [--threads K] [--chunk F] <sos file> <input> <output>\n");
+        return 1;
+    }
+
+    std::vector<double> sos = read_sos(paths[0]);
+
+    // map the input
+    MappedFile in;
+    struct stat st;
+
+    in.fd = open(paths[1], O_RDONLY);
+    if (in.fd < 0 || fstat(in.fd, &st) < 0) fail(std::string("cannot open ") + paths[1]);
+
+    in.size = st.st_size;
+    if (in.size == 0) fail(std::string("empty input ") + paths[1]);
+
+    in.data = static_cast<char*>(mmap(nullptr, in.size, PROT_READ, MAP_SHARED, in.fd, 0));
+    if (in.data == MAP_FAILED) { in.data = nullptr; fail("cannot map the input"); }
+
+    madvise(in.data, in.size, MADV_SEQUENTIAL);
+
+    // the samples: the data chunk of a WAV or the whole raw file
+    size_t offset = 0, bytes = in.size;
+    parse_wav(in.data, in.size, opt, offset, bytes);
+
+    if (opt.channels < 1 || opt.threads < 1 || opt.chunk < 1) fail("channels, threads and chunk must be positive");
+
+    const size_t bytes_per_sample = (opt.format == Format::f64) ? 8 : (opt.format == Format::f32) ? 4 : 2;
+    const long frames = bytes/(bytes_per_sample*opt.channels);
+
+    // map the output of the same size, the header and anything after the data are copied
+    MappedFile out;
+
+    out.fd = open(paths[2], O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (out.fd < 0 || ftruncate(out.fd, in.size) < 0) fail(std::string("cannot create ") + paths[2]);
+
+    out.size = in.size;
+    out.data = static_cast<char*>(mmap(nullptr, out.size, PROT_READ | PROT_WRITE, MAP_SHARED, out.fd, 0));
+    if (out.data == MAP_FAILED) { out.data = nullptr; fail("cannot map the output"); }
+
+    const size_t end = offset + frames*bytes_per_sample*opt.channels;
+
+    std::memcpy(out.data, in.data, offset);
+    std::memcpy(out.data + end, in.data + end, in.size - end);
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (opt.format == Format::f32) run<float, float>(opt, sos, in.data + offset, out.data + offset, frames);
+    if (opt.format == Format::f64) run<double, double>(opt, sos, in.data + offset, out.data + offset, frames);
+    if (opt.format == Format::s16) run<float, int16_t>(opt, sos, in.data + offset, out.data + offset, frames);
+
+    if (msync(out.data, out.size, MS_SYNC) < 0) fail("cannot write the output");
+
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double samples = double(frames)*opt.channels;
+
+    std::fprintf(stderr, "rfilter: %ld frames x %d channels, %zu sections, %.3f s, %.1f Msamples/s, %.1f MB/s\n",
+                 frames, opt.channels, sos.size()/5, s, samples/s*1e-6, 2*samples*bytes_per_sample/s*1e-6);
+
+    return 0;
+};